@@ -111,6 +111,23 @@ void glas_thread_exit(glas*);
  */
 void glas_thread_set_debug_name(glas*, char const* debug_name);
 
+/**
+ * API sessions.
+ * 
+ * Most API calls briefly coordinate with the garbage collector, costing
+ * a few atomic operations per call. A session holds this coordination 
+ * across a batch of calls, such that each call only checks whether GC 
+ * is waiting or the heap is full. Under heap pressure, a call within a
+ * session still waits for GC to catch up. Sessions nest. A session must end on the OS thread where
+ * it began, and a thread must not exit within a session.
+ * 
+ * GC cannot stop the world between calls within a session. Keep these
+ * short, and don't block within a session, e.g. awaiting another glas
+ * thread or a lock held by one.
+ */
+void glas_session_begin(glas*);
+void glas_session_end(glas*);
+
 /***************************
  * MEMORY MANAGEMENT
  **************************/
@@ -357,7 +374,7 @@ struct glas_file_ref {
     char const* src;
     char const* lang;
     bool embedded;
-} glas_file_ref;
+};
 
 
 
@@ -644,6 +661,35 @@ bool glas_u32_peek(glas*, uint32_t*);
 bool glas_u16_peek(glas*, uint16_t*);
 bool glas_u8_peek(glas*, uint8_t*);
 
+/**
+ * Push and peek for arrays of integers.
+ * 
+ * The runtime logically treats an array as a list of integers, but will
+ * hold it unboxed in a flat buffer of the given width. Push copies the
+ * array. Appending, splitting, or indexing integer arrays will preserve
+ * this representation where feasible.
+ * 
+ * Peek non-destructively reads a list of integers from top of the data
+ * stack, similar to glas_binary_peek. It returns 'true' if end-of-list
+ * was reached and everything available was read, or false with partial
+ * results if an item is not an integer in range or data is not a list.
+ * Peek does not cause a runtime error. If buf is NULL, the runtime will
+ * still compute amt_read and the return value.
+ */
+void glas_i64_array_push(glas*, int64_t const*, size_t len);
+void glas_i32_array_push(glas*, int32_t const*, size_t len);
+void glas_i16_array_push(glas*, int16_t const*, size_t len);
+void glas_i8_array_push(glas*, int8_t const*, size_t len);
+
+bool glas_i64_array_peek(glas*, size_t start_offset, size_t max_read,
+    int64_t* buf, size_t* amt_read);
+bool glas_i32_array_peek(glas*, size_t start_offset, size_t max_read,
+    int32_t* buf, size_t* amt_read);
+bool glas_i16_array_peek(glas*, size_t start_offset, size_t max_read,
+    int16_t* buf, size_t* amt_read);
+bool glas_i8_array_peek(glas*, size_t start_offset, size_t max_read,
+    int8_t* buf, size_t* amt_read);
+
 /**
  * Pointers - abstract client data
  * 
@@ -868,12 +914,29 @@ void glas_data_stash(glas*, int8_t amt);
  * local variables [a-zA-Z]. Then it scans rightwards from '-', pushing 
  * variables back onto the stack. It's an error if the string reuses a
  * variable on the left, refers to unassigned variables on the right, or
- * lacks the '-' separator. Copy or drop of linear data is detected.
- * 
+ * lacks the '-' separator, or if the right side exceeds GLAS_MOVES_MAX
+ * items. Copy or drop of linear data is detected.
+ *
  * Note: An invalid moves string may cause the process to abort.
  */
 void glas_data_move(glas*, char const* moves);
 
+/**
+ * Precompiled moves. For frequent shuffles, compile the moves string
+ * once then execute the plan, avoiding a parse per call. Compile returns
+ * false for an invalid moves string. Plans are plain values and may be
+ * shared between threads. Fields are private to the runtime.
+ */
+#define GLAS_MOVES_MAX 64
+typedef struct glas_moves {
+    uint8_t in;                     // items popped
+    uint8_t out;                    // items pushed
+    uint8_t src[GLAS_MOVES_MAX];    // input position per output
+    uint64_t linear_check;          // inputs dropped or copied
+} glas_moves;
+bool glas_moves_compile(glas_moves*, char const* moves);
+void glas_data_move_exec(glas*, glas_moves const*);
+
 
 /**
  * Primitive Operations
@@ -888,6 +951,39 @@ bool glas_unp(glas*);   // (A,B) -- A B | FAIL
 bool glas_unl(glas*);   // 0b0.X -- X   | FAIL
 bool glas_unr(glas*);   // 0b1.X -- X   | FAIL
 
+/**
+ * Batched Primitive Operations
+ *
+ * Runs an array of primitive data ops within one API call. This avoids
+ * per-op overheads for tight sequences, e.g. building or destructuring
+ * small values. The stack is prepared once for the whole batch.
+ *
+ * Returns count if every op succeeds, otherwise the index of the first
+ * op that fails: unp, unl, or unr on the wrong data, an invalid op or
+ * argument, or stack underflow (which also adds GLAS_E_UNDERFLOW). Ops
+ * before this index have been applied. As with the individual ops, copy
+ * or drop of linear data is recorded as an error but does not stop the
+ * batch.
+ */
+typedef enum glas_opcode {
+    GLAS_OP_MKP = 1,    // A B -- (A,B)
+    GLAS_OP_MKL,        // X -- 0b0.X
+    GLAS_OP_MKR,        // X -- 0b1.X
+    GLAS_OP_UNP,        // (A,B) -- A B | FAIL
+    GLAS_OP_UNL,        // 0b0.X -- X   | FAIL
+    GLAS_OP_UNR,        // 0b1.X -- X   | FAIL
+    GLAS_OP_COPY,       // arg 0..255, as glas_data_copy
+    GLAS_OP_DROP,       // arg 0..255, as glas_data_drop
+    GLAS_OP_SWAP,       // A B -- B A
+    GLAS_OP_STASH,      // arg -128..127, as glas_data_stash
+    GLAS_OP_I64,        // -- N ; integer arg
+} glas_opcode;
+typedef struct glas_op {
+    glas_opcode code;
+    int64_t arg;
+} glas_op;
+size_t glas_data_exec(glas*, glas_op const* ops, size_t count);
+
 /**
  * Non-modifying analyses. 
  */
@@ -907,14 +1003,15 @@ bool glas_data_is_ratio(glas*);     // dicts of form { n:Bits, d:Bits }, non-emp
 void glas_list_len(glas*);          // L -- L N         
 void glas_list_split(glas*);        // (L++R) (L len) -- L R
 void glas_list_append(glas*);       // L R -- (L++R)
+void glas_list_index(glas*);        // L N -- L X       ; copy of item N, from 0
 void glas_list_rev(glas*);          // reverse order of list
 
 /**
  * Bitstring Operations
  */
-void glas_bits_len(glas*);
-void glas_bits_split(glas*);
-void glas_bits_append(glas*);
+void glas_bits_len(glas*);          // B -- B N
+void glas_bits_split(glas*);        // (B1++B2) (B1 len) -- B1 B2
+void glas_bits_append(glas*);       // B1 B2 -- (B1++B2)
 void glas_bits_rev(glas*); // reverse order of bits
 void glas_bits_invert(glas*); // flip 0 to 1 and vice versa
 
@@ -927,6 +1024,11 @@ void glas_bits_invert(glas*); // flip 0 to 1 and vice versa
  * 
  * The 'to_bin' operation simply does the opposite. It's an error on
  * a bitstring that isn't a multiple of 8 bits in length.
+ * 
+ * Large binaries are viewed as bitstrings without copying, and to_bin
+ * returns to the same binary where the view remains byte-aligned. Thus
+ * converting back and forth is cheap, as are split and append within a
+ * converted bitstring.
  */
 void glas_bits_of_bin(glas*); // Binary -- Bitstring
 void glas_bits_to_bin(glas*); // Bitstring -- Binary
@@ -1005,6 +1107,15 @@ void glas_refl_bgcall(glas*, char const* op);
  */
 bool glas_rt_run_builtin_tests();
 
+/**
+ * Run library's built-in benchmarks.
+ * 
+ * Prints results to standard output. Benchmarks may take a few seconds
+ * and allocate a large heap. Returns 'false' if a benchmark could not
+ * run.
+ */
+bool glas_rt_run_builtin_bench();
+
 /**
  * Clear thread-local storage for calling thread.
  * 
@@ -1031,6 +1142,8 @@ void glas_rt_tls_reset();
 typedef enum glas_gc_flags {
     // 0 or bitwise 'or' of the following
     GLAS_GC_FULL = 0b1, // force full GC regardless of state 
+    GLAS_GC_MINOR = 0b10, // force a GC cycle, young generation only if possible
+    GLAS_GC_COMPACT = 0b100, // full GC, then evacuate sparse pages
 } glas_gc_flags;
 void glas_rt_gc_trigger(glas_gc_flags);
 
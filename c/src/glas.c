@@ -33,6 +33,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include <glas.h>
@@ -85,7 +86,45 @@ static_assert((ATOMIC_POINTER_LOCK_FREE == 2) &&
 #define GLAS_PAGE_CARD_COUNT (GLAS_HEAP_PAGE_SIZE >> GLAS_HEAP_CARD_SIZE_LG2)
 #define GLAS_CELL_SIZE 32
 #define GLAS_PAGE_CELL_COUNT (GLAS_HEAP_PAGE_SIZE / GLAS_CELL_SIZE)
-#define GLAS_CELL_BATCH_ALLOC 400
+#define GLAS_CELL_BATCH_ALLOC 400 // max cells per batch allocation
+
+/**
+ * Heap limits. GLAS_HEAP_MAX is a high-water mark for heap pages, in
+ * bytes. Above this, threads entering busy wait briefly for GC. This
+ * is a soft limit: a busy thread may allocate past it. After GC, we
+ * keep a few empty pages for reuse and return the rest to the OS.
+ */
+#ifndef GLAS_HEAP_MAX
+#define GLAS_HEAP_MAX (UINT64_C(16) << 30)
+#endif
+#define GLAS_HEAP_PAGES_MAX ((size_t)(GLAS_HEAP_MAX >> GLAS_HEAP_PAGE_SIZE_LG2))
+#define GLAS_HEAP_EMPTY_RESERVE 8   // empty pages kept for reuse
+#define GLAS_HEAP_PAGE_IDLE_CYCLES 4  // GC cycles before idle empty page is freed
+#define GLAS_HEAP_PRESSURE_CYCLES 3   // GC cycles to await under memory pressure
+
+/**
+ * Huge pages and NUMA. Our 2MB pages match x86-64 huge pages. By default
+ * we advise transparent huge pages. Define GLAS_HEAP_HUGETLB to try 
+ * explicit hugetlb heaps first; this needs huge pages reserved by the
+ * OS, else we fall back to normal heaps.
+ * 
+ * Pages are bound to the NUMA node of the thread that first allocates
+ * them, and recycled into per-node avail lists. On single-node systems,
+ * or where the syscalls are unavailable, everything is node 0.
+ */
+#ifndef GLAS_HEAP_THP
+#define GLAS_HEAP_THP 1
+#endif
+#define GLAS_NUMA_NODES_MAX 8
+
+/**
+ * Size classes. Class 0 pages hold 32-byte cells. Classes 1..7 hold 
+ * medium blocks of 64 bytes to 4kB, with one header cell per block
+ * followed by inline binary or array data. Blocks are marked at the
+ * header cell and reclaimed by lazy sweep, like any other cell.
+ */
+#define GLAS_SIZE_CLASS_COUNT 8
+#define GLAS_BLOCK_DATA_MAX ((GLAS_CELL_SIZE << (GLAS_SIZE_CLASS_COUNT - 1)) - GLAS_CELL_SIZE)
 
 #define GLAS_TIMEOUT_RES_NSEC (100 * 1000)
 
@@ -93,8 +132,9 @@ static_assert((ATOMIC_POINTER_LOCK_FREE == 2) &&
  * Current GC design:
  * - non-moving GC, concurrent mark + lazy sweep on alloc
  *   - similar to Go's GC 
- * - fixed-size cells, no compaction step
- *   - potentially can change to fixed size per page
+ * - fixed-size cells, occasional evacuation of sparse pages
+ *   - fixed size per page: 32-byte cells or medium blocks
+ *   - references fixed while stopped, cf. glas_os_thread_gc_safepoint
  * - concurrent mark requires a write barrier
  *   - TODO: mark entire root state on first use in barrier
  * - snapshot at the beginning
@@ -103,8 +143,9 @@ static_assert((ATOMIC_POINTER_LOCK_FREE == 2) &&
  *   - TODO: drop per-field trace bits; scan full cell atomically
  * - double mark buffers, flip buffers after mark completes
  *   - during concurrent mark, new allocations are marked
- * - non-generational, at least initially
- *   - pseudo-generational heuristic
+ * - generational via sticky mark bits, no copying
+ *   - minor cycles keep prior marks; only young cells are traced
+ *   - old-to-young pointers tracked by card marking per page
  * 
  * As part of lazy sweep, each OS thread allocates from its own page.
  * Pages are marked for reallocation after they undergo GC unless they
@@ -112,10 +153,57 @@ static_assert((ATOMIC_POINTER_LOCK_FREE == 2) &&
  */
 #define GLAS_GC_CELL_BUFFSZ 120
 #define GLAS_GC_STAT_SIZE 16
-#define GLAS_GC_POLL_USEC (10 * 1000)
-#define GLAS_GC_THREADS_MAX 8
-#define GLAS_GC_THREAD_IDLE_CYCLES 3
+#define GLAS_GC_IDLE_USEC (100 * 1000)
+
+/**
+ * GC pacing. After each cycle, we estimate live pages from marks and 
+ * set a goal of GLAS_GC_TARGET_PCT percent growth (cf. GOGC). The next
+ * cycle is started early enough that, allocating at the rate observed
+ * during the prior cycle, marking completes before the goal. Mutators
+ * wake GC upon acquiring the trigger page, so an idle GC just sleeps.
+ * The env var GLAS_GC_TARGET_PCT overrides the default.
+ */
+#ifndef GLAS_GC_TARGET_PCT
+#define GLAS_GC_TARGET_PCT 100
+#endif
+#define GLAS_GC_PACER_MIN_PAGES 16 // minimum runway between cycles
+#define GLAS_GC_THREADS_MAX 64
+#define GLAS_GC_DEQUE_SIZE 256
+#define GLAS_GC_WORKER_PAGES 8 // pages to trace that justify waking a worker
+#define GLAS_GC_WAKE_BACKLOG 4 // buffers in a deque that justify waking a worker
+#define GLAS_GC_PREFETCH_DIST 8 // cells prefetched ahead of tracing
+#define GLAS_GC_PREFETCH_NEAR (4 * GLAS_CELL_SIZE) // bytes, traced without ring
+#define GLAS_GC_MINOR_MAX 7
+#define GLAS_GC_COMPACT_PERIOD 8
+#define GLAS_GC_EVAC_PAGES_MIN 4
+#define GLAS_GC_EVAC_PAGES_MAX 32
+
+/**
+ * Foreign pointer decrefs. The finalizer pass is split across the main
+ * GC thread and parked GC workers. Each collects client decrefs into a
+ * private batch and hands batches off in bulk to a few decref workers,
+ * round robin. A slow client callback only delays
+ * batches sent to the same worker. Buffers owned by the runtime (big
+ * binaries, arrays) skip the queue: GC frees those inline. The env var
+ * GLAS_GC_DECREF_THREADS overrides the default worker count.
+ */
+#ifndef GLAS_GC_DECREF_THREADS
+#define GLAS_GC_DECREF_THREADS 2
+#endif
+#define GLAS_GC_DECREF_THREADS_MAX 16
+#define GLAS_GC_DECREF_BATCH 256
+
+/**
+ * Eager stack snapshots. Thread stacks and stashes are shaded in the
+ * stop-the-world that starts marking, so stack slot writes need no SATB
+ * barrier; see glas_stack_slot_write. Costs a few dozen slots per thread
+ * state in the pause. Set 0 to use per-write barriers on stacks instead.
+ */
+#ifndef GLAS_GC_EAGER_STACKS
+#define GLAS_GC_EAGER_STACKS 1
+#endif
 #define GLAS_THREAD_CHECKPOINT_MAX 9
+#define GLAS_THREAD_STATE_POOL_MAX 16 // recycled thread states per OS thread
 #define GLAS_STACK_MAX 32
 
 typedef struct glas_heap glas_heap; // mmap location    
@@ -312,18 +400,19 @@ typedef enum glas_type_id {
     GLAS_TYPE_SMALL_ARR,
     GLAS_TYPE_BIG_BIN,
     GLAS_TYPE_BIG_ARR,
+    GLAS_TYPE_INT_ARR,
     GLAS_TYPE_TAKE_CONCAT, 
     GLAS_TYPE_FOREIGN_PTR,
     GLAS_TYPE_REFERENCE,
     GLAS_TYPE_TOMBSTONE,
     GLAS_TYPE_SEAL,
+    GLAS_TYPE_STEM_OF_BIN,
     // under development
     GLAS_TYPE_THUNK,
     GLAS_TYPE_EXTREF,
     // experimental
     //GLAS_TYPE_SMALL_GLOB,   // interpret small_bin as glas object
     //GLAS_TYPE_BIG_GLOB,     // interpret big_bin as glas object
-    //GLAS_TYPE_STEM_OF_BIN, 
     // end of list
     GLAS_TYPEID_COUNT
 } glas_type_id;
@@ -346,8 +435,9 @@ static_assert(32 > GLAS_TYPEID_COUNT,
  *      special constants
  *    l: linear
  *      forbid copy and drop
- * gcbits: xxxxxxxt
+ * gcbits: xxxxfttt
  *    t: tracks whether a cell has been traced (for write barrier)
+ *    f: cell has a registered, unexecuted finalizer
  *    x: unused, tentatively could track cell age
  */
 struct glas_cell_hdr {
@@ -358,6 +448,7 @@ struct glas_cell_hdr {
 };
 // TODO: transition to one trace bit for full cell
 #define GLAS_GCBITS_SCAN    0b00000111
+#define GLAS_GCBITS_FIN     0b00001000
 #define GLAS_AGGR_LINEAR    0b0001
 #define GLAS_AGGR_ABSTRACT  0b0010
 #define GLAS_AGGR_EPH_MASK  0b1100
@@ -388,11 +479,15 @@ struct glas_cell {
             size_t len;
             glas_cell* fptr;
             // note: append aligned slices back together if fptr matches
+            // medium binaries (up to 4kB) are held in the GC heap, with
+            // fptr referring to the block header (cf. glas_block_alloc)
         } big_bin;
 
         struct {
             // big arrays are allocated outside the managed heap, using
-            // an fptr finalizer to clean up memory. Big arrays may be
+            // an fptr finalizer to clean up memory. Medium arrays (up to
+            // 4kB) are instead held in a heap block, with fptr referring
+            // to the block header. Big arrays may be
             // sliced logically. Slices may be rejoined into a big array
             // if they align exctly, recognized via the shared fptr.
             //
@@ -404,6 +499,14 @@ struct glas_cell {
             glas_cell* fptr;
         } big_arr;
 
+        struct {
+            // unboxed integers, each (1 << type_arg) bytes and signed.
+            // The buffer is held like big_bin, and slices may rejoin.
+            void const* data;
+            size_t len; // count of integers
+            glas_cell* fptr;
+        } int_arr;
+
         struct {
             // Foreign pointers are used in big arrays, big binaries, 
             // and abstract client data. 
@@ -416,6 +519,8 @@ struct glas_cell {
         struct {
             // for inner rope nodes, combines slicing with concatenation.
             // maybe add zero-fill for left suffix up to left_len, too.
+            // type_arg is rope height for balanced nodes, where left_len
+            // is exactly the length of left, or zero for plain slicing.
             uint64_t left_len;
             glas_cell* left;
             glas_cell* right;
@@ -485,11 +590,15 @@ struct glas_cell {
         // thread roots. 
 
         struct {
-            // (TENTATIVE)
-            // for very large stems or bitstrings, it is possible to
-            // directly represent the stem as a binary.
-            glas_cell* binary;
+            // a very large stem viewed directly from a binary. Bits are
+            // read msb first from each byte, starting at bit_offset into
+            // the binary. The stemHd bits, if any, precede the view.
+            // Views cover at most GLAS_STEM_OF_BIN_MAX bits; we chain
+            // views via fby for larger binaries.
+            glas_cell* binary;  // BIG_BIN cell
             glas_cell* fby;
+            uint32_t bit_offset;
+            uint32_t bit_len;   // non-zero
         } stem_of_bin;
 
     };
@@ -498,15 +607,25 @@ static_assert(GLAS_CELL_SIZE == sizeof(glas_cell), "invalid glas_cell size");
 
 struct glas_page {
     _Atomic(uint64_t) marks[2][GLAS_PAGE_CELL_COUNT/64]; // bit per mark
+    _Atomic(uint64_t) cards[GLAS_PAGE_CARD_COUNT/64]; // dirty bit per card
+    _Atomic(uint64_t) fcards[GLAS_PAGE_CARD_COUNT/64]; // finalizers per card
     _Atomic(uint64_t) *marking, *marked; // swapped per mark cycle
     uint8_t utilization[GLAS_GC_STAT_SIZE]; // inverse of free space last sweep
     uint8_t defer_reuse;    // delay sweep+realloc if utilization high
+    uint8_t size_class;     // objects of (1 << size_class) cells
+    uint8_t node;           // NUMA node, for recycling
 
     // track how long pages are held.
     uint64_t cycle_acquired;
     uint64_t cycle_released; 
+    uint64_t cycle_emptied; // for release of idle pages
+    _Atomic(bool) owned;    // allocating OS thread, don't recycle
+    bool evacuating;        // live cells moved, forwarding in small_arr[0]
+    bool fin;               // some fcards are set; GC private
+    _Atomic(bool) fin_pending; // finalizer pass due, don't alloc in fcards
 
     glas_page *gc_next;     // GC private linked list to reduce locking (rebuilt each cycle)
+    glas_page *fin_next;    // pages flagged fin_pending (rebuilt each cycle)
     glas_page *next;        // allocator linked lists
     glas_heap *heap;        // owning heap object
     uint64_t magic_word;    // only used in debug assertions
@@ -524,6 +643,7 @@ struct glas_heap {
     glas_heap* next;
     void* mem_start;
     _Atomic(uint64_t) page_bitmap;
+    bool hugetlb;           // backed by explicit huge pages
 };
 
 /**
@@ -558,14 +678,40 @@ struct glas_os_thread {
      * and has a high survival rate for data. To mitigate, we can track
      * how many allocations we got out of a page, and pull pages out of
      * circulation for a while if the number is low.
+     *
+     * One page is owned per size class. For medium blocks, free_bits
+     * only includes bits at the start of each block.
      */
     struct glas_os_thread_alloc {
         glas_page* page;        // owned page.
         size_t mark_word;       // offset into mark bitmap
         uint64_t free_bits;     // free bits from recent alloc
         size_t free_count;      // gc stat for heuristics
-    } alloc;
+        glas_page* cache;       // avail pages taken in batch, via 'next'
+    } alloc[GLAS_SIZE_CLASS_COUNT];
+
+    /**
+     * Acquired pages are added to the shared 'await' list in batches.
+     * GC drains these and the caches while the world is stopped.
+     */
+    glas_page *await_first, *await_last;
+    size_t await_count;
     glas_gc_fl* fl; // recently allocated finalizers
+
+    /**
+     * Snapshot-at-the-beginning buffer for write barriers. Old values
+     * are recorded locally, then handed to GC in bulk when the buffer
+     * is full or the thread leaves the busy state.
+     */
+    glas_gc_mb* satb;
+
+    /**
+     * Recycled thread states, linked via 'checkpoint'. These remain on
+     * the global roots list with cleared slots, thus steps and checkpoints
+     * don't need malloc or global roots list traffic.
+     */
+    struct glas_thread_state* ts_pool;
+    size_t ts_pool_count;
 };
 
 /**
@@ -611,6 +757,13 @@ struct glas_roots {
     size_t max_offset; 
     size_t root_count; 
 
+    /**
+     * The first eager_count roots are shaded when marking starts, while
+     * the world is stopped, cf. GLAS_GC_EAGER_STACKS. Writes to these
+     * slots need no barrier.
+     */
+    size_t eager_count;
+
     /**
      * A slot bitmap, computed based on root offsets.
      * 
@@ -644,10 +797,15 @@ typedef struct glas_sc {
  * 
  * A typed stack would be more flexible, but requires more sophisticated
  * integration with the garbage collector. We'll just use this for now. 
+ *
+ * Overflow is a list of chunks, each spilling several items at once. The
+ * spill target adapts to recent use: repeated spills keep fewer items on
+ * the stack, repeated refills keep more.
  */
 struct glas_stack {
     glas_cell* overflow;
     size_t count; // amount of data in use
+    int8_t spill_trend; // -3..3, negative after refills, positive after spills
     glas_sc data[GLAS_STACK_MAX];
 };
 #define GLAS_STACK_INDEX_DATA_CELL(index, host, name)\
@@ -689,6 +847,7 @@ struct glas {
     glas_thread_state* state;
     glas_thread_state* committed_state; // per-step transactions
     size_t step_count;
+    size_t session_depth; // OS thread held busy, cf. glas_session_begin
 
     GLAS_ERROR_FLAGS err; // unrecoverable errors
     bool has_abort_handlers; 
@@ -732,29 +891,71 @@ struct glas_gc_fl {
     glas_gc_fl* next;
 };
 
+/**
+ * Chase-Lev work-stealing deque of mark buffers, one per GC thread. 
+ * The owner pushes and pops at bottom, other GC threads steal from top.
+ * Capacity is fixed; if the deque is full, the owner spills buffers to
+ * a private list instead.
+ */
+typedef struct glas_gc_deque {
+    _Atomic(int64_t) top __attribute__((aligned(64))); // thieves
+    _Atomic(int64_t) bottom __attribute__((aligned(64))); // owner
+    glas_gc_mb* spill;  // owner only
+    uint64_t rng;       // owner only, for victim selection
+    _Atomic(glas_gc_mb*) buffer[GLAS_GC_DEQUE_SIZE];
+} __attribute__((aligned(64))) glas_gc_deque;
+
+/**
+ * Elastic pool of GC workers. Workers are created on demand by the main
+ * GC thread, up to 'max', and park on a shared semaphore between uses.
+ * Each cycle wakes workers in proportion to expected mark work, then
+ * more are woken (or created) if a deque backlog builds up.
+ */
 typedef struct glas_gc_wp {
-    pthread_t* workers; 
-    size_t count;
-    _Atomic(size_t) done;
+    pthread_t* workers; // up to 'max'
+    size_t max;
+    _Atomic(size_t) count;  // workers created
+    _Atomic(size_t) parked; // workers waiting on 'wakeup'
+    _Atomic(size_t) active; // woken workers holding or seeking mark work
+    _Atomic(bool) grow;     // backlog but no parked worker to wake
+    _Atomic(bool) open;     // may wake workers, i.e. concurrent marking
     sem_t wakeup; // shared semaphore
+    glas_gc_deque* deques; // main GC thread at 0, then workers; 1 + max
+    pthread_key_t deque_key;
 } glas_gc_wp;
 
-typedef struct glas_gc_dq {
-    pthread_t thread;
-    pthread_mutex_t mutex;
+typedef struct glas_gc_db glas_gc_db;
+struct glas_gc_db {
+    glas_gc_db* next;
+    size_t fill;
+    glas_refct items[GLAS_GC_DECREF_BATCH];
+};
+
+typedef struct glas_gc_dqw {
+    _Atomic(glas_gc_db*) inbox; // MPSC, taken whole by worker
     sem_t wakeup;
-    size_t head;
-    size_t tail;
-    glas_refct* items;
-    size_t capacity; 
-    // note: actual capacity is one less; 
-    // tail location is always empty.
+    pthread_t thread;
+} __attribute__((aligned(64))) glas_gc_dqw;
+
+typedef struct glas_gc_dq {
+    glas_gc_dqw* workers;
+    size_t count;
+    _Atomic(size_t) next; // round-robin handoff
 } glas_gc_dq;
 
+/**
+ * Shared page lists are Treiber stacks. Pages are aligned, so we tag
+ * low bits of the head with a modification count to resist ABA. Pages
+ * are freed only while stopped or after removal from every list, so a
+ * stale 'next' is always readable; the CAS just fails. Mutators mostly
+ * access these lists in batches, cf. glas_os_thread_page_acquire.
+ */
+#define GLAS_ALLOCL_TAG_MASK ((uintptr_t)(GLAS_HEAP_PAGE_SIZE - 1))
+#define GLAS_PAGE_CACHE_BATCH 4
 typedef struct glas_alloc_l {
-    _Atomic(glas_page*) page_list;
-    _Atomic(size_t) page_count;
-} glas_alloc_l;
+    _Atomic(uintptr_t) head;        // glas_page* | tag
+    _Atomic(size_t) page_count;     // approximate
+} __attribute__((aligned(64))) glas_alloc_l;
 
 static struct glas_rt {
     pthread_mutex_t mutex; // use sparingly!
@@ -773,12 +974,23 @@ static struct glas_rt {
         _Atomic(glas_heap*) heaps;
 
         /**
-         * Pages divided into two lists:
+         * Pages divided into a few lists:
          * - avail: estimated low utilization, not necessarily empty
          * - await: pages full or usage deferred to a later GC cycle
+         * - empty: no survivors, may be reused for any size class
+         * 
+         * The avail lists are per NUMA node and size class.
          */
-        glas_alloc_l avail, await;
+        glas_alloc_l avail[GLAS_NUMA_NODES_MAX][GLAS_SIZE_CLASS_COUNT], await, empty;
+        size_t node_count; // NUMA nodes, at least 1
         pthread_mutex_t mutex;
+
+        /**
+         * Pages claimed from heaps, compared to GLAS_HEAP_PAGES_MAX for
+         * back-pressure. Threads awaiting GC wait on 'cycle_done'.
+         */
+        _Atomic(size_t) page_count;
+        pthread_cond_t cycle_done;
     } alloc;
 
     struct glas_rt_root {
@@ -805,15 +1017,10 @@ static struct glas_rt {
         glas_roots* roots_snapshot;
         glas_page* pages; // via gc_next
 
-        /**
-         * During concurrent mark phase, put overflow scan buffers here. 
-         * Will eventually be useful with concurrent GC threads.
-         */
-        _Atomic(glas_gc_mb*) mb;
-        pthread_mutex_t gc_mb_pop_mutex; // guard against ABA issues
-        _Atomic(glas_cell*) wb; // from write-barriers
+        _Atomic(glas_gc_mb*) satb; // flushed from write-barriers
 
         _Atomic(glas_gc_fl*) fl;    // registered finalizers
+        _Atomic(glas_page*) fin_pages; // fin_pending, claimed by GC threads
         glas_gc_dq dq;              // decref queue for foreign pointers
 
         /**
@@ -839,16 +1046,42 @@ static struct glas_rt {
         /** 
          * For snapshot-at-the-beginning semantics, all new cells are
          * allocated in the scanned state by setting initial gcbits.
+         * 
+         * Cell scan bits flip only for full cycles. A minor cycle must
+         * trace cells allocated since the prior cycle, so between cycles
+         * new cells are allocated unscanned if the next cycle is minor.
+         * Thus, the kind of the next cycle is decided when the prior
+         * cycle completes. Roots are fully traced every cycle, so root
+         * scan bits flip every cycle.
          */
-        uint8_t gcbits;
+        uint8_t gcbits;         // initial gcbits for new cells
+        uint8_t scanbits;       // cell gcbits meaning 'scanned'
+        bool roots_b0scan;      // root slot bit 0 means 'scanned'
+        bool next_full;         // kind of next GC cycle
+        bool full_requested;    // full GC requested during minor cycles
+        uint8_t minor_count;    // minor cycles since last full cycle
+        bool compact_requested; // evacuate sparse pages in next full cycle
+        uint8_t full_count;     // full cycles since last compaction
+        _Atomic(bool) prefetch; // trace through prefetch ring, on by default
 
 
         /**
          * Stats at start of prior GC to guide heuristics
          */
-        uint64_t prior_page_ct; 
         uint64_t prior_root_ct; 
 
+        /**
+         * Pacer state. Allocation is measured in pages acquired by
+         * mutators, i.e. stat.page_alloc.
+         */
+        struct {
+            _Atomic(uint64_t) trigger_at; // page_alloc to start next cycle
+            uint64_t target_pct;    // heap growth goal, percent of live
+            uint64_t live_pages;    // estimated after prior cycle
+            uint64_t cycle_start;   // page_alloc at start of cycle
+            uint64_t cycle_alloc;   // smoothed pages acquired per cycle
+        } pacer;
+
         /**
          * API guidance of GC
          */
@@ -862,16 +1095,31 @@ static struct glas_rt {
         _Atomic(uint64_t) g_free;
         _Atomic(uint64_t) g_ts_alloc;   // checkpoints, steps
         _Atomic(uint64_t) g_ts_free;
+        _Atomic(uint64_t) g_ts_reuse;   // from per OS thread pools
         _Atomic(uint64_t) roots_init;   // GC roots (per slot)
         _Atomic(uint64_t) roots_free;
         _Atomic(uint64_t) tls_alloc;    // per OS thread
         _Atomic(uint64_t) tls_free;
         _Atomic(uint64_t) page_alloc;   // allocator and GC
         _Atomic(uint64_t) page_release;
+        _Atomic(uint64_t) page_remote;  // avail page taken from another node
         _Atomic(uint64_t) heap_alloc;   // mmaps
         _Atomic(uint64_t) heap_free;
-        _Atomic(uint64_t) gc_wb_resume;   // how many write-barriers activated
+        _Atomic(uint64_t) page_free;    // pages returned to OS
+        _Atomic(uint64_t) heap_pressure; // threads awaited GC on entry
+        _Atomic(uint64_t) gc_wb_resume;   // write-barrier snapshots, resumed marks
         _Atomic(uint64_t) gc_wb_stop;   // marked write-barriers when stopped
+        _Atomic(uint64_t) gc_steal;     // mark buffers taken from other GC threads
+        _Atomic(uint64_t) gc_mark_cells; // cells traced
+        _Atomic(uint64_t) gc_mark_nsec;  // concurrent mark through final trace
+        _Atomic(uint64_t) gc_minor;     // GC cycles, by kind
+        _Atomic(uint64_t) gc_full;
+        _Atomic(uint64_t) gc_paced;     // GC wakeups from passing the pacer trigger
+        _Atomic(uint64_t) gc_evac_pages;  // compaction
+        _Atomic(uint64_t) gc_evac_cells;
+        _Atomic(uint64_t) gc_fin_pages;   // pages visited by finalizer pass
+        _Atomic(uint64_t) decref_inline;  // runtime-owned buffers freed by GC
+        _Atomic(uint64_t) decref_queued;  // client decrefs handed to workers
     } stat;
 
 } glas_rt;
@@ -906,10 +1154,18 @@ LOCAL glas_os_thread* glas_os_thread_create() {
     sem_init(&(t->wakeup),0,0);
     return t;
 }
+LOCAL void glas_thread_state_pool_clear(glas_os_thread* t);
 LOCAL void glas_os_thread_destroy(glas_os_thread* t) {
     atomic_fetch_add_explicit(&glas_rt.stat.tls_free, 1, memory_order_relaxed);
+    glas_thread_state_pool_clear(t);
     sem_destroy(&(t->wakeup));
-    assert(likely((NULL == t->fl) && (NULL == t->alloc.page)));
+    assert(likely(NULL == t->fl));
+    assert(likely(0 == t->await_count));
+    assert(likely((NULL == t->satb) || (0 == t->satb->fill)));
+    free(t->satb);
+    for(size_t sc = 0; sc < GLAS_SIZE_CLASS_COUNT; ++sc) {
+        assert(likely((NULL == t->alloc[sc].page) && (NULL == t->alloc[sc].cache)));
+    }
     free(t);
 }
 LOCAL glas_os_thread* glas_os_thread_get_slowpath() {
@@ -924,16 +1180,22 @@ LOCAL inline glas_os_thread* glas_os_thread_get() {
     return likely(NULL != t) ? t : glas_os_thread_get_slowpath();
 }
 LOCAL void glas_gc_thread_init();
+LOCAL void glas_numa_init();
 LOCAL void glas_rt_init_slowpath() {
     pthread_mutex_init(&glas_rt.mutex, NULL);
     pthread_mutex_init(&glas_rt.alloc.mutex, NULL);
-    pthread_mutex_init(&glas_rt.gc.gc_mb_pop_mutex, NULL);
+    pthread_cond_init(&glas_rt.alloc.cycle_done, NULL);
+    glas_numa_init();
     pthread_key_create(&glas_rt.tls.key, &glas_os_thread_detach);
     sem_init(&(glas_rt.gc.wakeup), 0, 0);
     atomic_init(&glas_rt.root.conf, GLAS_VAL_UNIT);
     atomic_init(&glas_rt.root.globals, GLAS_VOID);
-    atomic_init(&glas_rt.gc.wb, GLAS_VOID);
+    atomic_init(&glas_rt.gc.satb, NULL);
+    atomic_init(&glas_rt.gc.fin_pages, NULL);
+    atomic_init(&glas_rt.gc.prefetch, true);
     atomic_init(&glas_rt.gc.cycle, 1);
+    glas_rt.gc.roots_b0scan = true;
+    glas_rt.gc.next_full = true;
     glas_gc_thread_init();
     // TBD: proper init of globals as lazy dict of ref.
     // TBD: Worker threads for on_commit.
@@ -1003,14 +1265,32 @@ LOCAL glas_heap* glas_heap_try_create() {
     glas_heap* heap = calloc(1,sizeof(glas_heap));
     if(unlikely(NULL == heap)) { return NULL; }
     heap->next = NULL;
+    heap->mem_start = MAP_FAILED;
+    #if defined(GLAS_HEAP_HUGETLB) && defined(MAP_HUGETLB)
+    // hugetlb mappings are aligned to the huge page size. Without the
+    // reservation, we'd get SIGBUS on first touch if the pool is short.
     heap->mem_start = mmap(NULL, GLAS_HEAP_MMAP_SIZE, PROT_NONE, 
-        MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
+        MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB,
         -1, 0);
+    heap->hugetlb = (MAP_FAILED != heap->mem_start);
+    #endif
+    if(MAP_FAILED == heap->mem_start) {
+        heap->mem_start = mmap(NULL, GLAS_HEAP_MMAP_SIZE, PROT_NONE, 
+            MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
+            -1, 0);
+    }
     if(unlikely(MAP_FAILED == heap->mem_start)) {
         debug("mmap failed to reserve memory for glas heap, error %d: %s", errno, strerror(errno));
         free(heap);
         return NULL;
     }
+    #if GLAS_HEAP_THP && defined(MADV_HUGEPAGE)
+    if(!heap->hugetlb) {
+        // advice is kept when mprotect splits the mapping. Not an error
+        // if THP is disabled, we'll just have more TLB misses.
+        (void) madvise(heap->mem_start, GLAS_HEAP_MMAP_SIZE, MADV_HUGEPAGE);
+    }
+    #endif
     heap->page_bitmap = glas_heap_initial_bitmap(heap);
     //debug("%luMB heap created at %p", (size_t)GLAS_HEAP_MMAP_SIZE>>20, heap->mem_start); 
     return heap;
@@ -1037,6 +1317,7 @@ LOCAL void* glas_heap_try_alloc_page(glas_heap* heap) {
                 debug("could not mark page for read+write, error %d: %s", errno, strerror(errno));
                 abort();
             }
+            atomic_fetch_add_explicit(&glas_rt.alloc.page_count, 1, memory_order_relaxed);
             return page;
         }
     }
@@ -1048,57 +1329,160 @@ LOCAL void glas_heap_free_page(glas_heap* heap, void* page) {
     size_t const ix = (size_t)((uintptr_t)page - (uintptr_t)glas_heap_pages_start(heap)) 
                 >> GLAS_HEAP_PAGE_SIZE_LG2;
     uint64_t const bit = UINT64_C(1)<<ix;
-    uint64_t const prior = atomic_fetch_and_explicit(&(heap->page_bitmap), ~bit, memory_order_relaxed);
-    assert(0 != (prior & bit));
-    if(unlikely(0 != mprotect(page, GLAS_HEAP_PAGE_SIZE, PROT_NONE))) {
-        debug("error protecting page %p from read-write, %d: %s", page, errno, strerror(errno));
-        // not a halting error
-    }
+    // protect before release, lest we race a concurrent allocation
     if(unlikely(0 != madvise(page, GLAS_HEAP_PAGE_SIZE, MADV_DONTNEED))) {
         debug("error expunging page %p from memory, %d: %s", page, errno, strerror(errno));
         // not a halting error, but may waste some memory
     }
+    if(unlikely(0 != mprotect(page, GLAS_HEAP_PAGE_SIZE, PROT_NONE))) {
+        debug("error protecting page %p from read-write, %d: %s", page, errno, strerror(errno));
+        // not a halting error
+    }
+    atomic_fetch_sub_explicit(&glas_rt.alloc.page_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&glas_rt.stat.page_free, 1, memory_order_relaxed);
+    uint64_t const prior = atomic_fetch_and_explicit(&(heap->page_bitmap), ~bit, memory_order_release);
+    assert(0 != (prior & bit));
+    (void)prior;
 }
 LOCAL inline uint64_t glas_page_magic_word_by_addr(void* addr) {
     static uint64_t const prime = UINT64_C(12233355555333221);
     return prime * (uint64_t)(((uintptr_t)addr)>>(GLAS_HEAP_PAGE_SIZE_LG2));
 }
-LOCAL void glas_page_init(glas_heap* heap, glas_page* page) {
+LOCAL void glas_page_init(glas_heap* heap, glas_page* page, size_t size_class) {
     assert(likely((glas_mem_page_ceil(page) == page) && 
-                   glas_heap_includes_addr(heap, page)));
+                   glas_heap_includes_addr(heap, page) &&
+                   (GLAS_SIZE_CLASS_COUNT > size_class)));
     memset(page, 0, sizeof(glas_page));
     page->marking = page->marks[0];
     page->marked = page->marks[1];
+    page->size_class = (uint8_t) size_class;
     page->heap = heap;
     page->magic_word = glas_page_magic_word_by_addr(page);
 }
+LOCAL void glas_page_reuse_empty(glas_page* page, size_t size_class) {
+    // an empty page has no survivors, so we can change its size class
+    assert(likely(GLAS_SIZE_CLASS_COUNT > size_class));
+    memset(page->utilization, 0, sizeof(page->utilization));
+    memset(page->cards, 0, sizeof(page->cards));
+    assert(likely(!page->fin)); // finalized before the page was emptied
+    page->defer_reuse = 0;
+    page->size_class = (uint8_t) size_class;
+}
+LOCAL bool glas_page_is_empty(glas_page* page) {
+    // only valid when page isn't concurrently allocated or marked
+    for(size_t ix = 0; ix < (GLAS_PAGE_CELL_COUNT/64); ++ix) {
+        if(0 != atomic_load_explicit(page->marked + ix, memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
 LOCAL inline glas_page* glas_page_from_internal_addr(void* addr) {
     glas_page* const page = (glas_page*) glas_mem_page_floor(addr);
     assert(likely(glas_page_magic_word_by_addr(page) == page->magic_word));
     return page;
 }
-LOCAL glas_page* glas_allocl_try_pop(glas_alloc_l* l) {
-    glas_page* page = atomic_load_explicit(&(l->page_list), memory_order_acquire);
-    do {} while((NULL != page) && atomic_compare_exchange_weak_explicit(&(l->page_list), 
-        &page, page->next, memory_order_acquire, memory_order_acquire));
-    if(NULL != page) {
-        atomic_fetch_sub_explicit(&(l->page_count), 1, memory_order_relaxed);
-        page->next = NULL;
+/**
+ * Finalizer cards. Cells with finalizers are tracked per card, i.e. four
+ * cells, then GLAS_GCBITS_FIN identifies the finalizer within a card. A
+ * mark word covers sixteen cards, so we spread card bits to cell bits and
+ * back again to compare with marks.
+ */
+static_assert(4 == (GLAS_HEAP_CARD_SIZE / GLAS_CELL_SIZE), "expecting four cells per card");
+LOCAL inline uint64_t glas_card_bits_to_cells(uint64_t cards16) {
+    uint64_t x = cards16 & 0xFFFF;
+    x = (x | (x << 24)) & UINT64_C(0x000000FF000000FF);
+    x = (x | (x << 12)) & UINT64_C(0x000F000F000F000F);
+    x = (x | (x << 6))  & UINT64_C(0x0303030303030303);
+    x = (x | (x << 3))  & UINT64_C(0x1111111111111111);
+    return x * 0xF;
+}
+LOCAL inline uint64_t glas_cell_bits_to_cards(uint64_t cells) {
+    // a card bit is set if any of its cells is set
+    uint64_t x = cells | (cells >> 1);
+    x = (x | (x >> 2)) & UINT64_C(0x1111111111111111);
+    x = (x | (x >> 3))  & UINT64_C(0x0303030303030303);
+    x = (x | (x >> 6))  & UINT64_C(0x000F000F000F000F);
+    x = (x | (x >> 12)) & UINT64_C(0x000000FF000000FF);
+    x = (x | (x >> 24)) & 0xFFFF;
+    return x;
+}
+LOCAL inline uint64_t glas_page_fin_cell_mask(glas_page* page, size_t mark_word) {
+    uint64_t const fcards = atomic_load_explicit(page->fcards + (mark_word / 4), memory_order_relaxed);
+    return glas_card_bits_to_cells(fcards >> (16 * (mark_word % 4)));
+}
+LOCAL inline glas_page* glas_allocl_head_page(uintptr_t head) {
+    return (glas_page*)(head & ~GLAS_ALLOCL_TAG_MASK);
+}
+LOCAL inline uintptr_t glas_allocl_head_update(uintptr_t prior, glas_page* page) {
+    assert(likely(0 == ((uintptr_t)page & GLAS_ALLOCL_TAG_MASK)));
+    return ((uintptr_t)page) | ((prior + 1) & GLAS_ALLOCL_TAG_MASK);
+}
+LOCAL inline glas_page* glas_allocl_peek(glas_alloc_l* l) {
+    // only stable while the world is stopped
+    return glas_allocl_head_page(atomic_load_explicit(&(l->head), memory_order_acquire));
+}
+LOCAL glas_page* glas_allocl_try_pop_batch(glas_alloc_l* l, size_t max) {
+    // pop up to 'max' pages as a NULL-terminated list
+    assert(likely(max > 0));
+    uintptr_t head = atomic_load_explicit(&(l->head), memory_order_acquire);
+    glas_page* first;
+    glas_page* last;
+    glas_page* rest;
+    size_t count;
+    do {
+        first = glas_allocl_head_page(head);
+        if(NULL == first) { return NULL; }
+        last = first;
+        count = 1;
+        rest = last->next;
+        while((count < max) && (NULL != rest)) {
+            last = rest;
+            rest = last->next;
+            ++count;
+        }
+    } while(!atomic_compare_exchange_weak_explicit(&(l->head), &head, 
+        glas_allocl_head_update(head, rest), memory_order_acquire, memory_order_acquire));
+    last->next = NULL;
+    atomic_fetch_sub_explicit(&(l->page_count), count, memory_order_relaxed);
+    return first;
+}
+LOCAL inline glas_page* glas_allocl_try_pop(glas_alloc_l* l) {
+    return glas_allocl_try_pop_batch(l, 1);
+}
+LOCAL void glas_allocl_push_chain(glas_alloc_l* l, glas_page* first, glas_page* last, size_t count) {
+    assert(likely((NULL != first) && (NULL != last) && (NULL == last->next)));
+    uintptr_t head = atomic_load_explicit(&(l->head), memory_order_relaxed);
+    do {
+        last->next = glas_allocl_head_page(head);
+    } while(!atomic_compare_exchange_weak_explicit(&(l->head), &head, 
+        glas_allocl_head_update(head, first), memory_order_release, memory_order_relaxed));
+    atomic_fetch_add_explicit(&(l->page_count), count, memory_order_relaxed);
+}
+LOCAL inline void glas_allocl_push(glas_alloc_l* l, glas_page* page) {
+    glas_allocl_push_chain(l, page, page, 1);
+}
+LOCAL glas_page* glas_allocl_take_all(glas_alloc_l* l) {
+    uintptr_t head = atomic_load_explicit(&(l->head), memory_order_relaxed);
+    do {} while(!atomic_compare_exchange_weak_explicit(&(l->head), &head,
+        glas_allocl_head_update(head, NULL), memory_order_acquire, memory_order_relaxed));
+    atomic_store_explicit(&(l->page_count), 0, memory_order_relaxed);
+    return glas_allocl_head_page(head);
+}
+LOCAL bool glas_rt_heaps_are_full() {
+    for(glas_heap* heap = atomic_load_explicit(&glas_rt.alloc.heaps, memory_order_acquire);
+        (NULL != heap); heap = heap->next)
+    {
+        if(!glas_heap_is_full(heap)) { return false; }
     }
-    return page;
-}
-LOCAL void glas_allocl_push(glas_alloc_l* l, glas_page* page) {
-    assert(likely((NULL != page) && (NULL == page->next)));
-    atomic_pushlist(&(l->page_list), &(page->next), page);
-    atomic_fetch_add_explicit(&(l->page_count), 1, memory_order_relaxed);
+    return true;
 }
 LOCAL bool glas_rt_grow_full_heap() {
     bool ok = false;
     // goal here is to have a non-full heap. Locking this to avoid
     // race where a thread must immediately return a heap to the OS.
     glas_rt_alloc_lock();
-    glas_heap* const curr_heap = atomic_load_explicit(&glas_rt.alloc.heaps, memory_order_acquire);
-    if((NULL == curr_heap) || glas_heap_is_full(curr_heap)) {
+    if(glas_rt_heaps_are_full()) {
         glas_heap* const new_heap = glas_heap_try_create();
         if(NULL != new_heap) {
             atomic_pushlist(&glas_rt.alloc.heaps, &(new_heap->next), new_heap);
@@ -1111,23 +1495,154 @@ LOCAL bool glas_rt_grow_full_heap() {
     glas_rt_alloc_unlock();
     return ok;
 }
-LOCAL glas_page* glas_rt_page_alloc() {
-    atomic_fetch_add_explicit(&glas_rt.stat.page_alloc, 1, memory_order_relaxed);
+LOCAL void glas_numa_init() {
+    // count possible nodes, e.g. "0" or "0-1" or "0,2-3"
+    glas_rt.alloc.node_count = 1;
+    FILE* const f = fopen("/sys/devices/system/node/possible", "r");
+    if(NULL == f) { return; }
+    unsigned int node_max = 0;
+    unsigned int n;
+    while(1 == fscanf(f, "%u", &n)) {
+        node_max = (n > node_max) ? n : node_max;
+        int const sep = fgetc(f);
+        if((',' != sep) && ('-' != sep)) { break; }
+    }
+    fclose(f);
+    glas_rt.alloc.node_count = (node_max < GLAS_NUMA_NODES_MAX) ? 
+        (node_max + 1) : GLAS_NUMA_NODES_MAX;
+}
+LOCAL size_t glas_numa_node_current() {
+    // threads may migrate, so only a hint. Used when acquiring pages.
+    if(1 == glas_rt.alloc.node_count) { return 0; }
+    #ifdef SYS_getcpu
+    unsigned int cpu, node;
+    if((0 == syscall(SYS_getcpu, &cpu, &node, NULL)) && (node < glas_rt.alloc.node_count)) {
+        return node;
+    }
+    #endif
+    return 0;
+}
+LOCAL void glas_numa_bind_page(void* page, size_t node) {
+    // prefer node; the kernel may fall back to other nodes
+    (void)page; (void)node;
+    #ifdef SYS_mbind
+    if(glas_rt.alloc.node_count > 1) {
+        static int const mpol_preferred = 1; // MPOL_PREFERRED, from numaif.h
+        unsigned long nodemask = (1UL << node);
+        (void) syscall(SYS_mbind, page, (unsigned long)GLAS_HEAP_PAGE_SIZE, 
+            mpol_preferred, &nodemask, (unsigned long)(8 * sizeof(nodemask)), 0);
+    }
+    #endif
+}
+LOCAL inline glas_alloc_l* glas_rt_avail(size_t node, size_t size_class) {
+    assert(likely((node < glas_rt.alloc.node_count) && (size_class < GLAS_SIZE_CLASS_COUNT)));
+    return glas_rt.alloc.avail[node] + size_class;
+}
+LOCAL glas_page* glas_rt_page_try_alloc_empty(size_t size_class, size_t node) {
+    glas_page* page = glas_allocl_try_pop(&glas_rt.alloc.empty);
+    if(NULL != page) {
+        glas_page_reuse_empty(page, size_class);
+        return page;
+    }
+    // older heaps may have pages returned to the OS
+    for(glas_heap* heap = atomic_load_explicit(&glas_rt.alloc.heaps, memory_order_acquire);
+        (NULL != heap); heap = heap->next)
+    {
+        page = glas_heap_try_alloc_page(heap);
+        if(NULL != page) {
+            glas_numa_bind_page(page, node); // before first touch
+            glas_page_init(heap, page, size_class);
+            page->node = (uint8_t) node;
+            return page;
+        }
+    }
+    return NULL;
+}
+LOCAL glas_page* glas_rt_page_alloc_empty(size_t size_class, size_t node) {
+    // allocate a page without any survivors
     do {
-        glas_page* page = glas_allocl_try_pop(&glas_rt.alloc.avail);
+        glas_page* const page = glas_rt_page_try_alloc_empty(size_class, node);
         if(NULL != page) { 
             return page; 
         }
-        glas_heap* heap = atomic_load_explicit(&glas_rt.alloc.heaps, memory_order_relaxed);
-        page = (NULL == heap) ? NULL : glas_heap_try_alloc_page(heap);
-        if(NULL != page) {
-            glas_page_init(heap, page);
-            return page;
+        if(atomic_load_explicit(&glas_rt.alloc.page_count, memory_order_relaxed) >= GLAS_HEAP_PAGES_MAX) {
+            // soft limit, but ask GC to catch up
+            atomic_store_explicit(&glas_rt.gc.trigger, true, memory_order_relaxed);
         }
     } while(glas_rt_grow_full_heap());
     debug("runtime is out of memory!");
     abort();
 }
+LOCAL glas_page* glas_rt_page_alloc(size_t size_class, size_t node) {
+    // after local avail list: empty pages, then remote pages before 
+    // growing the heap
+    glas_page* page = glas_rt_page_try_alloc_empty(size_class, node);
+    for(size_t ix = 1; ((NULL == page) && (ix < glas_rt.alloc.node_count)); ++ix) {
+        size_t const remote = (node + ix) % glas_rt.alloc.node_count;
+        page = glas_allocl_try_pop(glas_rt_avail(remote, size_class));
+        if(NULL != page) {
+            atomic_fetch_add_explicit(&glas_rt.stat.page_remote, 1, memory_order_relaxed);
+        }
+    }
+    if(NULL == page) {
+        return glas_rt_page_alloc_empty(size_class, node);
+    }
+    assert(likely(size_class == page->size_class));
+    return page;
+}
+LOCAL void glas_os_thread_await_flush(glas_os_thread* t) {
+    if(0 != t->await_count) {
+        glas_allocl_push_chain(&glas_rt.alloc.await, t->await_first, t->await_last, t->await_count);
+        t->await_first = NULL;
+        t->await_last = NULL;
+        t->await_count = 0;
+    }
+}
+LOCAL void glas_os_thread_await_push(glas_os_thread* t, glas_page* page) {
+    assert(likely(NULL == page->next));
+    page->next = t->await_first;
+    if(NULL == t->await_first) {
+        t->await_last = page;
+    }
+    t->await_first = page;
+    if(++(t->await_count) >= GLAS_PAGE_CACHE_BATCH) {
+        glas_os_thread_await_flush(t);
+    }
+}
+LOCAL void glas_os_thread_drain_pages(glas_os_thread* t) {
+    // return cached pages; only while busy or while the world is stopped
+    glas_os_thread_await_flush(t);
+    for(size_t sc = 0; sc < GLAS_SIZE_CLASS_COUNT; ++sc) {
+        struct glas_os_thread_alloc* const a = t->alloc + sc;
+        while(NULL != a->cache) {
+            glas_page* const page = a->cache;
+            a->cache = page->next;
+            page->next = NULL;
+            glas_allocl_push(glas_rt_avail(page->node, sc), page);
+        }
+    }
+}
+LOCAL glas_page* glas_os_thread_page_acquire(glas_os_thread* t, size_t size_class) {
+    // acquire page for allocation, registering it for the next GC
+    uint64_t const n = 1 + atomic_fetch_add_explicit(&glas_rt.stat.page_alloc, 1, memory_order_relaxed);
+    if(unlikely(n == atomic_load_explicit(&glas_rt.gc.pacer.trigger_at, memory_order_relaxed))) {
+        atomic_fetch_add_explicit(&glas_rt.stat.gc_paced, 1, memory_order_relaxed);
+        sem_post(&glas_rt.gc.wakeup); // exactly one thread acquires this page
+    }
+    struct glas_os_thread_alloc* const a = t->alloc + size_class;
+    if(NULL == a->cache) {
+        size_t const node = glas_numa_node_current();
+        a->cache = glas_allocl_try_pop_batch(glas_rt_avail(node, size_class), GLAS_PAGE_CACHE_BATCH);
+        if(NULL == a->cache) {
+            a->cache = glas_rt_page_alloc(size_class, node);
+        }
+    }
+    glas_page* const page = a->cache;
+    a->cache = page->next;
+    page->next = NULL;
+    glas_os_thread_await_push(t, page);
+    return page;
+}
 LOCAL inline bool glas_os_thread_is_busy() {
     glas_os_thread* const t = pthread_getspecific(glas_rt.tls.key);
     return ((NULL != t) && (GLAS_OS_THREAD_BUSY == t->state));
@@ -1154,67 +1669,191 @@ LOCAL void glas_page_swept(glas_page* page, size_t amt_freed) {
     size_t const r80 = glas_page_utilization_run_of(page, UINT8_C(205));
     page->defer_reuse = (uint8_t)(r66/2 + r80);
 }
-LOCAL void glas_os_thread_release_page(glas_os_thread* t) {
+LOCAL void glas_os_thread_release_page(glas_os_thread* t, size_t size_class) {
     atomic_fetch_add_explicit(&glas_rt.stat.page_release, 1, memory_order_relaxed);
-    if(NULL != t->alloc.page) { 
-        t->alloc.page->cycle_released = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
-        glas_page_swept(t->alloc.page, t->alloc.free_count);
+    struct glas_os_thread_alloc* const a = t->alloc + size_class;
+    if(NULL != a->page) { 
+        a->page->cycle_released = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
+        glas_page_swept(a->page, (a->free_count << size_class));
+        atomic_store_explicit(&(a->page->owned), false, memory_order_release);
     }
-    t->alloc.page = NULL;
-    t->alloc.mark_word = 0;
-    t->alloc.free_bits = 0;
-    t->alloc.free_count = 0;
+    a->page = NULL;
+    a->mark_word = 0;
+    a->free_bits = 0;
+    a->free_count = 0;
+}
+/**
+ * Geometry of size classes. Each object is `(1 << size_class)` cells, 
+ * aligned to its own size. Only the first mark bit of each object is
+ * used, so we mask free bits to object starts. Objects of 64 cells or
+ * more are aligned to mark words, and we step over words.
+ */
+LOCAL inline size_t glas_size_class_first_cell(size_t size_class) {
+    static_assert(0 == (sizeof(glas_page)%sizeof(glas_cell)));
+    size_t const hdr_cells = sizeof(glas_page)/sizeof(glas_cell);
+    size_t const obj_cells = ((size_t)1) << size_class;
+    return ((hdr_cells + (obj_cells - 1)) / obj_cells) * obj_cells;
+}
+LOCAL inline size_t glas_size_class_word_stride(size_t size_class) {
+    return (size_class > 6) ? (((size_t)1) << (size_class - 6)) : 1;
+}
+LOCAL inline size_t glas_size_class_last_word(size_t size_class) {
+    return (GLAS_PAGE_CELL_COUNT - (((size_t)1) << size_class)) / 64;
 }
-LOCAL void glas_os_thread_alloc_reserve(glas_os_thread* t) {
-    // return with t->free_bits or bust!
+LOCAL inline uint64_t glas_size_class_start_mask(size_t size_class) {
+    // e.g. 0b0101..01 for two-cell objects
+    return (size_class >= 6) ? UINT64_C(1) : 
+        (UINT64_MAX / ((UINT64_C(1) << (((size_t)1) << size_class)) - 1));
+}
+LOCAL void glas_os_thread_alloc_reserve(glas_os_thread* t, size_t size_class) {
+    // return with t->alloc[size_class].free_bits or bust!
     // This will sweep pages as part of finding allocations.
-    assert(likely((GLAS_OS_THREAD_BUSY == t->state) && (0 == t->alloc.free_bits)));
+    struct glas_os_thread_alloc* const a = t->alloc + size_class;
+    assert(likely((GLAS_OS_THREAD_BUSY == t->state) && (0 == a->free_bits)));
     static_assert(0 == (GLAS_PAGE_CELL_COUNT % 64));
-    static size_t const MARK_WORD_MAX = (GLAS_PAGE_CELL_COUNT/64) - 1; // one bit per cell
+    size_t const stride = glas_size_class_word_stride(size_class);
+    size_t const last_word = glas_size_class_last_word(size_class);
+    uint64_t const start_mask = glas_size_class_start_mask(size_class);
     do {
-        if(unlikely((NULL == t->alloc.page) || (MARK_WORD_MAX == t->alloc.mark_word))) {
-            glas_os_thread_release_page(t);
-            t->alloc.page = glas_rt_page_alloc();
-            glas_allocl_push(&glas_rt.alloc.await, t->alloc.page);
-            t->alloc.page->cycle_acquired = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
-            assert(likely(t->alloc.page->cycle_acquired > t->alloc.page->cycle_released));
-            // begin allocation immediately after `glas_page` header
-            static_assert(0 == (sizeof(glas_page)%sizeof(glas_cell)));
-            static size_t const HDR_MARK_BITS = sizeof(glas_page)/sizeof(glas_cell);
-            static size_t const HDR_END = HDR_MARK_BITS/64;
-            static uint64_t const HDR_REM = (UINT64_C(1)<<(HDR_MARK_BITS%64))-1;
-            uint64_t const survivors = atomic_load_explicit((t->alloc.page->marked + HDR_END), memory_order_relaxed);
-            t->alloc.mark_word = HDR_END;
-            t->alloc.free_bits = ~(HDR_REM | survivors);
+        if(unlikely((NULL == a->page) || ((a->mark_word + stride) > last_word))) {
+            glas_os_thread_release_page(t, size_class);
+            a->page = glas_os_thread_page_acquire(t, size_class);
+            assert(likely(!atomic_load_explicit(&(a->page->owned), memory_order_relaxed)));
+            atomic_store_explicit(&(a->page->owned), true, memory_order_relaxed);
+            a->page->cycle_acquired = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
+            // begin allocation at first aligned object after `glas_page` header
+            size_t const first_cell = glas_size_class_first_cell(size_class);
+            uint64_t const hdr_rem = (UINT64_C(1)<<(first_cell%64))-1;
+            a->mark_word = first_cell / 64;
+            uint64_t const survivors = atomic_load_explicit((a->page->marked + a->mark_word), memory_order_relaxed);
+            a->free_bits = ~(hdr_rem | survivors) & start_mask;
         } else {
-            ++(t->alloc.mark_word);
-            uint64_t const survivors = atomic_load_explicit((t->alloc.page->marked + t->alloc.mark_word), memory_order_relaxed);
-            t->alloc.free_bits = ~survivors;
+            a->mark_word += stride;
+            uint64_t const survivors = atomic_load_explicit((a->page->marked + a->mark_word), memory_order_relaxed);
+            a->free_bits = ~survivors & start_mask;
+        }
+        if(unlikely(atomic_load_explicit(&(a->page->fin_pending), memory_order_acquire))) {
+            // dead finalizers in these cards aren't yet run
+            a->free_bits &= ~glas_page_fin_cell_mask(a->page, a->mark_word);
         }
-    } while(0 == t->alloc.free_bits);
-    t->alloc.free_count += popcount64(t->alloc.free_bits);
+    } while(0 == a->free_bits);
+    a->free_count += popcount64(a->free_bits);
     if(glas_rt.gc.marking) {
         // Mark all new allocations during concurrent mark phase. This ensures
         // they aren't reallocated immediately when we swap marked and marking.
-        atomic_fetch_or_explicit((t->alloc.page->marking + t->alloc.mark_word), 
-            t->alloc.free_bits, memory_order_relaxed);
+        atomic_fetch_or_explicit((a->page->marking + a->mark_word), 
+            a->free_bits, memory_order_relaxed);
     }
 }
 LOCAL inline bool glas_gc_b0scan() {
-    // return true iff a 0 bit means 'scanned'
-    return (0 == (1 & glas_rt.gc.gcbits));
+    // return true iff a 0 bit means 'scanned' for cells
+    return (0 == glas_rt.gc.scanbits);
 }
-LOCAL glas_cell* glas_cell_alloc() {
-    glas_os_thread* const t = glas_os_thread_get();
-    if(unlikely(0 == t->alloc.free_bits)) {
-        glas_os_thread_alloc_reserve(t);
+LOCAL inline bool glas_gc_roots_b0scan() {
+    // return true iff a 0 bit means 'scanned' for roots
+    return glas_rt.gc.roots_b0scan;
+}
+LOCAL inline glas_cell* glas_os_thread_alloc_take(glas_os_thread* t, size_t size_class) {
+    struct glas_os_thread_alloc* const a = t->alloc + size_class;
+    if(unlikely(0 == a->free_bits)) {
+        glas_os_thread_alloc_reserve(t, size_class);
     }
-    size_t ix = ctz64(t->alloc.free_bits);
-    t->alloc.free_bits &= (t->alloc.free_bits - 1);
-    glas_cell* const cell = ((glas_cell*)(t->alloc.page)) + ((t->alloc.mark_word) * 64) + ix;
+    size_t ix = ctz64(a->free_bits);
+    a->free_bits &= (a->free_bits - 1);
+    glas_cell* const cell = ((glas_cell*)(a->page)) + ((a->mark_word) * 64) + ix;
     atomic_init(&(cell->hdr.gcbits), glas_rt.gc.gcbits); 
     return cell;
 }
+LOCAL inline glas_cell* glas_cell_alloc() {
+    return glas_os_thread_alloc_take(glas_os_thread_get(), 0);
+}
+LOCAL size_t glas_os_thread_alloc_run(glas_os_thread* t, size_t count) {
+    // Given a fully free mark word in free_bits, reserve the following
+    // fully free words of the page as one run, up to count cells. Returns
+    // cells taken from the start of the run; the rest stay in free_bits.
+    struct glas_os_thread_alloc* const a = t->alloc;
+    assert(likely(UINT64_MAX == a->free_bits));
+    glas_page* const page = a->page;
+    size_t const last_word = glas_size_class_last_word(0);
+    bool const fin_pending = atomic_load_explicit(&(page->fin_pending), memory_order_acquire);
+    size_t n = 64;
+    while((n < count) && (a->mark_word < last_word)) {
+        size_t const w = a->mark_word + 1;
+        if((0 != atomic_load_explicit(page->marked + w, memory_order_relaxed)) ||
+           (fin_pending && (0 != glas_page_fin_cell_mask(page, w)))) 
+        {
+            break; // end of run
+        }
+        if(glas_rt.gc.marking) {
+            atomic_fetch_or_explicit(page->marking + w, UINT64_MAX, memory_order_relaxed);
+        }
+        a->mark_word = w;
+        a->free_count += 64;
+        n += 64;
+    }
+    size_t const take = (n < count) ? n : count;
+    size_t const rem = n - take; // unused tail of the last word
+    a->free_bits = (0 == rem) ? 0 : (UINT64_MAX << (64 - rem));
+    return take;
+}
+/**
+ * Allocate `count` cells in one call. Cells are not contiguous in general,
+ * but fully free mark words are bump-allocated as a contiguous run, which
+ * may span most of a fresh page, so a batch costs one reservation instead
+ * of one per word. The caller must initialize all cells before the next
+ * GC safepoint.
+ */
+LOCAL void glas_os_thread_alloc_batch(glas_os_thread* t, glas_cell** cells, size_t count) {
+    assert(likely(count <= GLAS_CELL_BATCH_ALLOC)); // bound uninitialized cells
+    struct glas_os_thread_alloc* const a = t->alloc;
+    uint8_t const gcbits = glas_rt.gc.gcbits;
+    while(count > 0) {
+        if(unlikely(0 == a->free_bits)) {
+            glas_os_thread_alloc_reserve(t, 0);
+        }
+        glas_cell* const base = ((glas_cell*)(a->page)) + ((a->mark_word) * 64);
+        if(UINT64_MAX == a->free_bits) {
+            // bump allocation from a run of fully free words
+            size_t const n = glas_os_thread_alloc_run(t, count);
+            for(size_t ix = 0; ix < n; ++ix) {
+                cells[ix] = base + ix;
+                atomic_init(&(cells[ix]->hdr.gcbits), gcbits);
+            }
+            cells += n;
+            count -= n;
+        } else {
+            do {
+                size_t const ix = ctz64(a->free_bits);
+                a->free_bits &= (a->free_bits - 1);
+                (*cells) = base + ix;
+                atomic_init(&((*cells)->hdr.gcbits), gcbits);
+                ++cells;
+                --count;
+            } while((0 != a->free_bits) && (count > 0));
+        }
+    }
+}
+LOCAL inline void glas_cell_alloc_batch(glas_cell** cells, size_t count) {
+    glas_os_thread_alloc_batch(glas_os_thread_get(), cells, count);
+}
+LOCAL inline size_t glas_block_size_class(size_t data_size) {
+    // smallest class to fit header cell and data_size bytes
+    assert(likely((0 < data_size) && (GLAS_BLOCK_DATA_MAX >= data_size)));
+    size_t const cells = (data_size + (2 * sizeof(glas_cell)) - 1) / sizeof(glas_cell);
+    return (size_t)(64 - clz64((uint64_t)(cells - 1)));
+}
+/**
+ * Allocate a medium block for data_size bytes. Returns the header cell,
+ * with data immediately following. The caller must initialize header
+ * and data before the next GC safepoint.
+ */
+LOCAL glas_cell* glas_block_alloc(size_t data_size) {
+    return glas_os_thread_alloc_take(glas_os_thread_get(), 
+                glas_block_size_class(data_size));
+}
+LOCAL inline void* glas_block_data(glas_cell* block) {
+    return (void*)(block + 1);
+}
 LOCAL inline glas_cell* glas_cell_clone(glas_cell* cell) {
     assert(likely(GLAS_DATA_IS_PTR(cell)));
     glas_cell* result = glas_cell_alloc();
@@ -1229,20 +1868,6 @@ LOCAL glas_gc_fl* glas_gc_fl_new() {
     fl->next = NULL;
     return fl;
 }
-LOCAL void glas_gc_fl_compact(glas_gc_fl* fl) {
-    if(NULL == fl) { return; }
-    while(NULL != fl->next) {
-        if(GLAS_GC_CELL_BUFFSZ >= (fl->fill + fl->next->fill)) {
-            glas_gc_fl* const tmp = fl->next;
-            fl->next = tmp->next;
-            memcpy(fl->buffer + fl->fill, tmp->buffer, (sizeof(glas_cell*) * tmp->fill));
-            fl->fill += tmp->fill;
-            free(tmp);
-        } else {
-            fl = fl->next;
-        }
-    }
-}
 LOCAL void glas_gc_register_finalizer(glas_cell* cell) {
     assert(likely(GLAS_DATA_IS_PTR(cell) && glas_os_thread_is_busy()));
     // record into thread-local list of new finalizers
@@ -1255,6 +1880,7 @@ LOCAL void glas_gc_register_finalizer(glas_cell* cell) {
         t->fl = glas_gc_fl_new();
     }
     t->fl->buffer[(t->fl->fill)++] = cell;
+    atomic_fetch_or_explicit(&(cell->hdr.gcbits), GLAS_GCBITS_FIN, memory_order_relaxed);
 }
 LOCAL inline glas_cell* glas_cell_fptr(void* ptr, glas_refct pin, bool linear) {
     glas_cell* cell = glas_cell_alloc();
@@ -1281,8 +1907,23 @@ LOCAL void glas_cell_binary_refct_upd(void* fptr, bool incref) {
         }
     }
 }
+/**
+ * Slices of big binaries and arrays hold a reference to the owner of 
+ * the buffer. This is usually a foreign pointer with a finalizer, but
+ * medium blocks are their own owner, i.e. `fptr` refers to the header
+ * cell of the block.
+ */
+LOCAL inline bool glas_cell_is_buffer_owner(glas_cell* cell) {
+    static_assert(offsetof(glas_cell, big_bin.fptr) == offsetof(glas_cell, big_arr.fptr));
+    static_assert(offsetof(glas_cell, big_bin.fptr) == offsetof(glas_cell, int_arr.fptr));
+    return (GLAS_TYPE_FOREIGN_PTR == cell->hdr.type_id) ||
+           (((GLAS_TYPE_BIG_BIN == cell->hdr.type_id) || 
+             (GLAS_TYPE_BIG_ARR == cell->hdr.type_id) ||
+             (GLAS_TYPE_INT_ARR == cell->hdr.type_id)) &&
+            (cell == cell->big_bin.fptr));
+}
 LOCAL glas_cell* glas_cell_binary_slice(uint8_t const* data, size_t len, glas_cell* fptr) {
-    assert(likely(GLAS_TYPE_FOREIGN_PTR == fptr->hdr.type_id));
+    assert(likely(glas_cell_is_buffer_owner(fptr)));
     glas_cell* const slice = glas_cell_alloc();
     slice->hdr.type_id = GLAS_TYPE_BIG_BIN;
     slice->hdr.type_arg = 0;
@@ -1293,6 +1934,28 @@ LOCAL glas_cell* glas_cell_binary_slice(uint8_t const* data, size_t len, glas_ce
     slice->big_bin.fptr = fptr;
     return slice;
 }
+LOCAL glas_cell* glas_cell_binary_alloc_uninit(size_t len, uint8_t** data) {
+    // a BIG_BIN of len bytes, for the caller to fill in place
+    assert(likely(24 < len));
+    if(GLAS_BLOCK_DATA_MAX >= len) {
+        glas_cell* const cell = glas_block_alloc(len);
+        (*data) = glas_block_data(cell);
+        cell->hdr.type_id = GLAS_TYPE_BIG_BIN;
+        cell->hdr.type_arg = 0;
+        cell->hdr.type_aggr = 0;
+        cell->stemHd = GLAS_STEM31_EMPTY;
+        cell->big_bin.data = (*data);
+        cell->big_bin.len = len;
+        cell->big_bin.fptr = cell;
+        return cell;
+    } else {
+        void* const addr = malloc(sizeof(_Atomic(size_t)) + len); // include space for refct
+        atomic_init((_Atomic(size_t)*) addr, 1);
+        (*data) = (uint8_t*)(((uintptr_t)addr) + sizeof(_Atomic(size_t)));
+        glas_refct const pin = { .refct_obj = addr, .refct_upd = glas_cell_binary_refct_upd };
+        return glas_cell_binary_slice((*data), len, glas_cell_fptr((*data), pin, false));
+    }
+}
 LOCAL glas_cell* glas_cell_binary_alloc(uint8_t const* data, size_t len) {
     if(7 >= len) {
         // use a packed pointer
@@ -1313,12 +1976,10 @@ LOCAL glas_cell* glas_cell_binary_alloc(uint8_t const* data, size_t len) {
         memcpy(cell->small_bin, data, len);
         return cell;
     } else {
-        void* const addr = malloc(sizeof(_Atomic(size_t)) + len); // include space for refct
-        atomic_init((_Atomic(size_t)*) addr, 1);
-        uint8_t* const data_copy = (uint8_t*)(((uintptr_t)addr) + sizeof(_Atomic(size_t)));
-        memcpy(data_copy,data,len);
-        glas_refct const pin = { .refct_obj = addr, .refct_upd = glas_cell_binary_refct_upd };
-        return glas_cell_binary_slice(data_copy, len, glas_cell_fptr(data_copy, pin, false));
+        uint8_t* data_copy;
+        glas_cell* const cell = glas_cell_binary_alloc_uninit(len, &data_copy);
+        memcpy(data_copy, data, len);
+        return cell;
     }
 }
 LOCAL inline uint8_t glas_type_aggr_comp(uint8_t lhs, uint8_t rhs) {
@@ -1351,7 +2012,7 @@ LOCAL void glas_cell_array_free(void* base_ptr, bool incref) {
     free(base_ptr);
 }
 LOCAL glas_cell* glas_cell_array_slice(glas_cell** data, size_t len, uint8_t type_aggr, glas_cell* fptr) {
-    assert(likely(GLAS_TYPE_FOREIGN_PTR == fptr->hdr.type_id));
+    assert(likely(glas_cell_is_buffer_owner(fptr)));
     glas_cell* const slice = glas_cell_alloc();
     slice->hdr.type_id = GLAS_TYPE_BIG_ARR;
     slice->hdr.type_arg = 0;
@@ -1362,18 +2023,35 @@ LOCAL glas_cell* glas_cell_array_slice(glas_cell** data, size_t len, uint8_t typ
     slice->big_arr.fptr = fptr;
     return slice;
 }
+LOCAL glas_cell* glas_cell_small_arr_init(glas_cell* cell, glas_cell** data, size_t len) {
+    // initialize a freshly allocated cell as an array of 1..3 items
+    assert(likely((0 < len) && (len < 4)));
+    cell->hdr.type_id = GLAS_TYPE_SMALL_ARR;
+    cell->hdr.type_arg = len;
+    cell->hdr.type_aggr = glas_cell_array_type_aggr(data, len);
+    cell->stemHd = GLAS_STEM31_EMPTY;
+    cell->small_arr[0] = data[0];
+    cell->small_arr[1] = (len > 1) ? data[1] : GLAS_VOID;
+    cell->small_arr[2] = (len > 2) ? data[2] : GLAS_VOID;
+    return cell;
+}
 LOCAL glas_cell* glas_cell_array_alloc(glas_cell** data, size_t len) {
     // array as a list
     if(len < 4) {
         if(0 == len) { return GLAS_VAL_UNIT; }
-        glas_cell* const cell = glas_cell_alloc();
-        cell->hdr.type_id = GLAS_TYPE_SMALL_ARR;
-        cell->hdr.type_arg = len;
-        cell->hdr.type_aggr = glas_cell_array_type_aggr(data, len);
+        return glas_cell_small_arr_init(glas_cell_alloc(), data, len);
+    } else if(GLAS_BLOCK_DATA_MAX >= (len * sizeof(glas_cell*))) {
+        size_t const total_size = len * sizeof(glas_cell*);
+        glas_cell* const cell = glas_block_alloc(total_size);
+        glas_cell** const data_copy = glas_block_data(cell);
+        memcpy(data_copy, data, total_size);
+        cell->hdr.type_id = GLAS_TYPE_BIG_ARR;
+        cell->hdr.type_arg = 0;
+        cell->hdr.type_aggr = glas_cell_array_type_aggr(data_copy, len);
         cell->stemHd = GLAS_STEM31_EMPTY;
-        cell->small_arr[0] = data[0];
-        cell->small_arr[1] = (len > 1) ? data[1] : GLAS_VOID;
-        cell->small_arr[2] = (len > 2) ? data[2] : GLAS_VOID;
+        cell->big_arr.data = data_copy;
+        cell->big_arr.len = len;
+        cell->big_arr.fptr = cell;
         return cell;
     } else {
         size_t const total_size = len * sizeof(glas_cell**);
@@ -1387,6 +2065,66 @@ LOCAL glas_cell* glas_cell_array_alloc(glas_cell** data, size_t len) {
 }
 LOCAL glas_cell* glas_sc_to_cell(glas_sc sc);
 LOCAL void glas_sc_fill_cell_stem_bits(glas_sc* sc);
+/**
+ * Unboxed integer arrays, a list of integers with a fixed width. Width
+ * is recorded in type_arg as log2 of bytes per item, 0..3 for int8_t to
+ * int64_t. We hold the buffer like big binaries. Very short arrays are
+ * instead boxed into a small array, which fits in one cell.
+ */
+LOCAL glas_sc glas_data_i64(int64_t const n);
+LOCAL inline int64_t glas_int_buf_get(void const* data, uint8_t width, size_t ix) {
+    switch(width) {
+        case 0: return ((int8_t const*)data)[ix];
+        case 1: return ((int16_t const*)data)[ix];
+        case 2: return ((int32_t const*)data)[ix];
+        default: return ((int64_t const*)data)[ix];
+    }
+}
+LOCAL inline int64_t glas_int_arr_get(glas_cell const* cell, size_t ix) {
+    return glas_int_buf_get(cell->int_arr.data, cell->hdr.type_arg, ix);
+}
+LOCAL glas_cell* glas_cell_int_array_slice(void const* data, size_t len, uint8_t width, glas_cell* fptr) {
+    assert(likely(glas_cell_is_buffer_owner(fptr) && (width < 4)));
+    glas_cell* const slice = glas_cell_alloc();
+    slice->hdr.type_id = GLAS_TYPE_INT_ARR;
+    slice->hdr.type_arg = width;
+    slice->hdr.type_aggr = 0;
+    slice->stemHd = GLAS_STEM31_EMPTY;
+    slice->int_arr.data = data;
+    slice->int_arr.len = len;
+    slice->int_arr.fptr = fptr;
+    return slice;
+}
+LOCAL glas_cell* glas_cell_int_array_alloc(void const* data, size_t len, uint8_t width) {
+    assert(likely(width < 4));
+    size_t const size = len << width;
+    if(len < 4) {
+        glas_cell* items[3];
+        for(size_t ix = 0; ix < len; ++ix) {
+            items[ix] = glas_sc_to_cell(glas_data_i64(glas_int_buf_get(data, width, ix)));
+        }
+        return glas_cell_array_alloc(items, len);
+    } else if(GLAS_BLOCK_DATA_MAX >= size) {
+        glas_cell* const cell = glas_block_alloc(size);
+        void* const data_copy = glas_block_data(cell);
+        memcpy(data_copy, data, size);
+        cell->hdr.type_id = GLAS_TYPE_INT_ARR;
+        cell->hdr.type_arg = width;
+        cell->hdr.type_aggr = 0;
+        cell->stemHd = GLAS_STEM31_EMPTY;
+        cell->int_arr.data = data_copy;
+        cell->int_arr.len = len;
+        cell->int_arr.fptr = cell;
+        return cell;
+    } else {
+        void* const addr = malloc(sizeof(_Atomic(size_t)) + size); // include space for refct
+        atomic_init((_Atomic(size_t)*) addr, 1);
+        void* const data_copy = (void*)(((uintptr_t)addr) + sizeof(_Atomic(size_t)));
+        memcpy(data_copy, data, size);
+        glas_refct const pin = { .refct_obj = addr, .refct_upd = glas_cell_binary_refct_upd };
+        return glas_cell_int_array_slice(data_copy, len, width, glas_cell_fptr(data_copy, pin, false));
+    }
+}
 LOCAL inline bool glas_cell_is_short_stem(glas_cell* cell) {
     // short stem of 0..31 bits only
     return (GLAS_DATA_IS_PTR(cell) &&
@@ -1417,12 +2155,10 @@ LOCAL inline void glas_sc_branch_prep(glas_sc* sc) {
     glas_sc_fill_cell_stem_bits(sc); // compress stem bits into sc->cell
     glas_sc_branch_prep_collapse_long_stem(sc); // oversized stems need separate node
 }
-LOCAL glas_cell* glas_cell_pair_alloc_sc(glas_sc lhs, glas_sc rhs) {
-    // TBD: packed pointers for shrubs or small binaries
+LOCAL void glas_cell_pair_init_sc(glas_cell* cell, glas_sc lhs, glas_sc rhs) {
+    // initialize a freshly allocated cell as a pair
     glas_sc_branch_prep(&lhs);
     glas_sc_branch_prep(&rhs);
-
-    glas_cell* cell = glas_cell_alloc();
     cell->hdr.type_id = GLAS_TYPE_BRANCH;
     cell->hdr.type_arg = 0;
     cell->hdr.type_aggr = glas_type_aggr_comp(
@@ -1432,6 +2168,11 @@ LOCAL glas_cell* glas_cell_pair_alloc_sc(glas_sc lhs, glas_sc rhs) {
     cell->branch.stemR = (uint32_t) (rhs.stem >> 32);
     cell->branch.L = lhs.cell;
     cell->branch.R = rhs.cell;
+}
+LOCAL glas_cell* glas_cell_pair_alloc_sc(glas_sc lhs, glas_sc rhs) {
+    // TBD: packed pointers for shrubs or small binaries
+    glas_cell* const cell = glas_cell_alloc();
+    glas_cell_pair_init_sc(cell, lhs, rhs);
     return cell;
 }
 LOCAL inline glas_cell* glas_cell_pair_alloc(glas_cell* lhs, glas_cell* rhs) {
@@ -1452,13 +2193,37 @@ LOCAL void glas_os_thread_force_enter_busy(glas_os_thread* t) {
             return; // successfully entered busy
         }
         // otherwise, wait for GC wakeup. We'll check for GC once more to
-        // avoid a missed wakeup race condition.
-        atomic_fetch_sub_explicit(&(glas_rt.gc.busy_threads_count), 1, memory_order_relaxed);
+        // avoid a missed wakeup race condition. If GC observed our brief
+        // increment, we might be the last 'busy' thread and must awaken GC.
+        size_t const prior_busy_count = atomic_fetch_sub_explicit(&(glas_rt.gc.busy_threads_count), 1, memory_order_release);
+        if(1 == prior_busy_count) {
+            sem_post(&glas_rt.gc.wakeup);
+        }
         if(likely(atomic_load_explicit(&(glas_rt.gc.stopping), memory_order_relaxed))) {
             sem_wait(&(t->wakeup));
         }
     } while(1);
 }
+LOCAL inline bool glas_rt_heap_pressure() {
+    return (atomic_load_explicit(&glas_rt.alloc.page_count, memory_order_relaxed) >= GLAS_HEAP_PAGES_MAX);
+}
+LOCAL void glas_rt_await_memory() {
+    // Back-pressure. Wait for GC to catch up, but only for a few cycles;
+    // if the live heap is larger than GLAS_HEAP_MAX, we must continue.
+    // The GC thread runs finalizers, so must not wait on itself.
+    if(pthread_equal(pthread_self(), glas_rt.gc.gc_main_thread)) { return; }
+    atomic_fetch_add_explicit(&glas_rt.stat.heap_pressure, 1, memory_order_relaxed);
+    uint64_t const cycle_max = GLAS_HEAP_PRESSURE_CYCLES + 
+        atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    glas_rt_alloc_lock();
+    while(glas_rt_heap_pressure() && 
+          (cycle_max > atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire))) 
+    {
+        glas_rt_gc_trigger(GLAS_GC_FULL);
+        pthread_cond_wait(&glas_rt.alloc.cycle_done, &glas_rt.alloc.mutex);
+    }
+    glas_rt_alloc_unlock();
+}
 LOCAL void glas_os_thread_enter_busy() {
     glas_os_thread* const t = glas_os_thread_get();
     if(GLAS_OS_THREAD_BUSY == t->state) {
@@ -1466,10 +2231,18 @@ LOCAL void glas_os_thread_enter_busy() {
         return;
     }
     assert(likely(GLAS_OS_THREAD_IDLE == t->state));
+    if(unlikely(glas_rt_heap_pressure())) {
+        glas_rt_await_memory();
+    }
     glas_os_thread_force_enter_busy(t);
 }
+LOCAL void glas_os_thread_satb_flush(glas_os_thread*);
 LOCAL void glas_os_thread_force_exit_busy(glas_os_thread* const t) {
     assert(likely(GLAS_OS_THREAD_BUSY == t->state));
+    if((NULL != t->satb) && (0 < t->satb->fill)) {
+        // GC must see snapshots before we stop blocking it
+        glas_os_thread_satb_flush(t);
+    }
     t->state = GLAS_OS_THREAD_IDLE;
     t->busy_depth = 0;
     size_t const prior_busy_count = atomic_fetch_sub_explicit(&glas_rt.gc.busy_threads_count, 1, memory_order_release);
@@ -1497,6 +2270,17 @@ LOCAL void glas_os_thread_gc_safepoint_slowpath() {
     glas_os_thread_force_enter_busy(t);
     t->busy_depth = saved_busy_depth;
 }
+LOCAL void glas_os_thread_await_memory_slowpath() {
+    // back-pressure while busy, e.g. within a session; the same as on entry
+    // but we must leave busy so GC can stop the world
+    glas_os_thread* const t = glas_os_thread_get();
+    assert(likely(GLAS_OS_THREAD_BUSY == t->state));
+    size_t const saved_busy_depth = t->busy_depth;
+    glas_os_thread_force_exit_busy(t);
+    glas_rt_await_memory();
+    glas_os_thread_force_enter_busy(t);
+    t->busy_depth = saved_busy_depth;
+}
 /**
  * A gc safepoint should be set within unbounded computations, and must
  * be set where it's safe to move data for compacting collections. That
@@ -1508,16 +2292,32 @@ LOCAL inline void glas_os_thread_gc_safepoint() {
         glas_os_thread_gc_safepoint_slowpath();
     }
 }
+LOCAL void glas_os_thread_alloc_unreserve(glas_os_thread* t, size_t size_class) {
+    // Return reserved cells. During marking, reserved cells are marked so
+    // we must unmark them, otherwise GC would see uninitialized 'cells'.
+    struct glas_os_thread_alloc* const a = t->alloc + size_class;
+    assert(likely(GLAS_OS_THREAD_BUSY == t->state));
+    if((0 != a->free_bits) && glas_rt.gc.marking) {
+        atomic_fetch_and_explicit((a->page->marking + a->mark_word),
+            ~(a->free_bits), memory_order_relaxed);
+    }
+    a->free_count -= popcount64(a->free_bits);
+    a->free_bits = 0;
+}
 LOCAL void glas_os_thread_set_done(glas_os_thread* const t) {
     if(GLAS_OS_THREAD_BUSY == t->state) {
         debug("OS thread canceled while busy");
         glas_os_thread_force_exit_busy(t);
     }
     assert(GLAS_OS_THREAD_IDLE == t->state);
-    if(NULL != t->alloc.page) {
-        t->alloc.page->cycle_released = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
-        t->alloc.page = NULL;
+    // release pages while busy to coordinate with GC
+    glas_os_thread_force_enter_busy(t);
+    for(size_t sc = 0; sc < GLAS_SIZE_CLASS_COUNT; ++sc) {
+        glas_os_thread_alloc_unreserve(t, sc);
+        glas_os_thread_release_page(t, sc);
     }
+    glas_os_thread_drain_pages(t);
+    glas_os_thread_force_exit_busy(t);
     t->state = GLAS_OS_THREAD_DONE;
 }
 LOCAL inline bool glas_gc_has_stopped_the_world() {
@@ -1560,22 +2360,146 @@ LOCAL void glas_gc_mb_free(glas_gc_mb* mblist) {
         free(mb);
     }
 }
-LOCAL void glas_gc_mb_grow(glas_gc_mb** mbhd) {
-    // We'll rotate up to two buffers locally to avoid touching the 
-    // global shared list at the overflow boundary 
-    assert(likely(GLAS_GC_CELL_BUFFSZ == (*mbhd)->fill));
-    glas_gc_mb* mb = (*mbhd)->next;
-    (*mbhd)->next = NULL;
-    if(NULL == mb) {
-        mb = glas_gc_mb_new();
-    } else {
-        assert(likely(NULL == mb->next)); // keep at most two local buffers
-        if(glas_gc_mb_is_empty(mb)) {
-            // recycle empty buffer, a no-op here
-        } else {
-            // two full buffers, push one to global list for work sharing
+LOCAL void glas_gc_deque_init(glas_gc_deque* dq, uint64_t seed) {
+    atomic_init(&dq->top, 0);
+    atomic_init(&dq->bottom, 0);
+    dq->spill = NULL;
+    dq->rng = seed | 1; // xorshift state must be non-zero
+    for(size_t ix = 0; ix < GLAS_GC_DEQUE_SIZE; ++ix) {
+        atomic_init(dq->buffer + ix, NULL);
+    }
+}
+LOCAL inline glas_gc_deque* glas_gc_deque_self() {
+    return (glas_gc_deque*) pthread_getspecific(glas_rt.gc.pool.deque_key);
+}
+LOCAL inline bool glas_gc_deque_is_empty(glas_gc_deque* dq) {
+    // may be stale; only a hint when used concurrently
+    int64_t const t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    int64_t const b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    return (b <= t);
+}
+LOCAL bool glas_gc_deque_push(glas_gc_deque* dq, glas_gc_mb* mb) {
+    // owner only; returns false if full
+    int64_t const b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    int64_t const t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    if((b - t) >= GLAS_GC_DEQUE_SIZE) {
+        return false;
+    }
+    atomic_store_explicit(dq->buffer + (b % GLAS_GC_DEQUE_SIZE), mb, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&dq->bottom, (b + 1), memory_order_relaxed);
+    return true;
+}
+LOCAL glas_gc_mb* glas_gc_deque_pop(glas_gc_deque* dq) {
+    // owner only; races thieves for the last item
+    int64_t const b = atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&dq->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&dq->top, memory_order_relaxed);
+    if(t > b) {
+        // was empty
+        atomic_store_explicit(&dq->bottom, (b + 1), memory_order_relaxed);
+        return NULL;
+    }
+    glas_gc_mb* mb = atomic_load_explicit(dq->buffer + (b % GLAS_GC_DEQUE_SIZE), memory_order_relaxed);
+    if(t == b) {
+        if(!atomic_compare_exchange_strong_explicit(&dq->top, &t, (t + 1), 
+                memory_order_seq_cst, memory_order_relaxed)) 
+        {
+            mb = NULL; // lost race to a thief
+        }
+        atomic_store_explicit(&dq->bottom, (b + 1), memory_order_relaxed);
+    }
+    return mb;
+}
+LOCAL glas_gc_mb* glas_gc_deque_steal(glas_gc_deque* dq) {
+    // any thread; returns NULL if empty or upon losing a race
+    int64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t const b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    if(t >= b) {
+        return NULL;
+    }
+    glas_gc_mb* const mb = atomic_load_explicit(dq->buffer + (t % GLAS_GC_DEQUE_SIZE), memory_order_relaxed);
+    if(!atomic_compare_exchange_strong_explicit(&dq->top, &t, (t + 1), 
+            memory_order_seq_cst, memory_order_relaxed)) 
+    {
+        return NULL;
+    }
+    return mb;
+}
+LOCAL void glas_gc_workers_wake_backlog();
+LOCAL void glas_gc_deque_share(glas_gc_mb* mb) {
+    glas_gc_deque* const dq = glas_gc_deque_self();
+    if(!glas_gc_deque_push(dq, mb)) {
+        mb->next = dq->spill;
+        dq->spill = mb;
+        glas_gc_workers_wake_backlog();
+    } else if(GLAS_GC_WAKE_BACKLOG <= 
+        (atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 
+         atomic_load_explicit(&dq->top, memory_order_relaxed)))
+    {
+        glas_gc_workers_wake_backlog();
+    }
+}
+LOCAL glas_gc_mb* glas_gc_deque_find_work() {
+    glas_gc_deque* const self = glas_gc_deque_self();
+
+    // spilled buffers first, so the deque remains available to thieves
+    glas_gc_mb* mb = self->spill;
+    if(NULL != mb) {
+        self->spill = mb->next;
+        mb->next = NULL;
+        return mb;
+    }
+    mb = glas_gc_deque_pop(self);
+    if(NULL != mb) {
+        return mb;
+    }
+
+    // steal, starting from a random victim to spread contention
+    size_t const n = 1 + glas_rt.gc.pool.max;
+    self->rng ^= self->rng << 13;
+    self->rng ^= self->rng >> 7;
+    self->rng ^= self->rng << 17;
+    size_t const start = (size_t)(self->rng % n);
+    for(size_t ix = 0; ix < n; ++ix) {
+        glas_gc_deque* const victim = glas_rt.gc.pool.deques + ((start + ix) % n);
+        if(victim == self) {
+            continue;
+        }
+        mb = glas_gc_deque_steal(victim);
+        if(NULL != mb) {
+            atomic_fetch_add_explicit(&glas_rt.stat.gc_steal, 1, memory_order_relaxed);
+            return mb;
+        }
+    }
+    return NULL;
+}
+LOCAL bool glas_gc_deques_are_empty() {
+    for(size_t ix = 0; ix <= glas_rt.gc.pool.max; ++ix) {
+        if(!glas_gc_deque_is_empty(glas_rt.gc.pool.deques + ix)) {
+            return false;
+        }
+    }
+    return true;
+}
+LOCAL void glas_gc_mb_grow(glas_gc_mb** mbhd) {
+    // We'll rotate up to two buffers locally to avoid touching the 
+    // shared deque at the overflow boundary 
+    assert(likely(GLAS_GC_CELL_BUFFSZ == (*mbhd)->fill));
+    glas_gc_mb* mb = (*mbhd)->next;
+    (*mbhd)->next = NULL;
+    if(NULL == mb) {
+        mb = glas_gc_mb_new();
+    } else {
+        assert(likely(NULL == mb->next)); // keep at most two local buffers
+        if(glas_gc_mb_is_empty(mb)) {
+            // recycle empty buffer, a no-op here
+        } else {
+            // two full buffers, push one to our deque for work sharing
             assert(likely(GLAS_GC_CELL_BUFFSZ == mb->fill));
-            atomic_pushlist(&glas_rt.gc.mb, &(mb->next), mb);
+            glas_gc_deque_share(mb);
             mb = glas_gc_mb_new();
         }
     }
@@ -1588,6 +2512,15 @@ LOCAL inline void glas_gc_mb_push(glas_gc_mb** mb, glas_cell* data) {
     }
     (*mb)->buffer[((*mb)->fill)++] = data;
 }
+LOCAL void glas_gc_drain_page_caches() {
+    // pages cached by threads must be visible to GC in shared lists
+    assert(likely(glas_gc_has_stopped_the_world()));
+    for(glas_os_thread* t = atomic_load_explicit(&glas_rt.tls.list, memory_order_acquire); 
+        (NULL != t); t = t->next) 
+    {
+        glas_os_thread_drain_pages(t);
+    }
+}
 LOCAL glas_os_thread* glas_gc_extract_done_threads() {
     assert(likely(glas_gc_has_stopped_the_world()));
     glas_os_thread* tdone = NULL;
@@ -1632,9 +2565,12 @@ LOCAL glas_roots* glas_gc_extract_detached_roots() {
 // - GC and worker threads
 // - moving and marking GC
 
-LOCAL void glas_roots_init(glas_roots* r, void* self, void (*finalizer)(void*), uint16_t const* roots) {
+LOCAL void glas_roots_init(glas_roots* r, void* self, void (*finalizer)(void*), 
+    uint16_t const* roots, size_t eager_count) 
+{
     assert(NULL != self);
     r->self = self;
+    r->eager_count = eager_count;
     r->finalizer = finalizer;
     r->roots = roots;
     atomic_init(&(r->refct), 1);
@@ -1659,7 +2595,7 @@ LOCAL void glas_roots_init(glas_roots* r, void* self, void (*finalizer)(void*),
     // 'scan' roots while busy to lock down scan bit
     // also add to roots list while GC is blocked 
     glas_os_thread_enter_busy();
-    memset(r->slot_bitmap, (glas_gc_b0scan() ? 0 : ~0), bitmap_len); // mark roots scanned
+    memset(r->slot_bitmap, (glas_gc_roots_b0scan() ? 0 : ~0), bitmap_len); // mark roots scanned
     atomic_pushlist(&glas_rt.root.list, &(r->next), r);
     glas_os_thread_exit_busy();
 }
@@ -1684,7 +2620,7 @@ LOCAL bool glas_wb_claim_roots_slot(glas_roots* r, glas_cell** slot) {
     size_t const slot_ix = (size_t) (slot - base);
     uint64_t const bit = UINT64_C(1) << (slot_ix % 64);
     _Atomic(uint64_t)* const pbitmap = r->slot_bitmap + (slot_ix / 64);
-    if(glas_gc_b0scan()) {
+    if(glas_gc_roots_b0scan()) {
         uint64_t const prior = atomic_fetch_and_explicit(pbitmap, ~bit, memory_order_release);
         return (0 != (prior & bit));
     } else {
@@ -1712,13 +2648,26 @@ LOCAL bool glas_gc_try_cell_mark(glas_cell* cell) {
     uint64_t const prior = atomic_fetch_or_explicit(pbitmap, bit, memory_order_relaxed);
     return (0 == (prior & bit));
 }
+LOCAL void glas_os_thread_satb_flush(glas_os_thread* t) {
+    // hand a buffer of marked, untraced cells to GC 
+    glas_gc_mb* const mb = t->satb;
+    t->satb = NULL;
+    atomic_fetch_add_explicit(&glas_rt.stat.gc_wb_resume, mb->fill, memory_order_relaxed);
+    atomic_pushlist(&glas_rt.gc.satb, &(mb->next), mb);
+}
 LOCAL inline void glas_wb_snapshot_push(glas_cell* cell) {
-    // allocating a cell for every write-barrier snapshot; should be rare!
-    // keep some stats on how often this happens
-    atomic_fetch_add_explicit(&glas_rt.stat.gc_wb_resume, 1, memory_order_relaxed);
-    glas_cell* const wb = glas_cell_alloc(); // just using as memory
-    wb->small_arr[1] = cell;
-    atomic_pushlist(&glas_rt.gc.wb, wb->small_arr, wb);
+    // A thread that isn't busy doesn't reach a flush point, so it hands
+    // over its snapshot immediately. This is rare.
+    glas_os_thread* const t = glas_os_thread_get();
+    if(unlikely(NULL == t->satb)) {
+        t->satb = glas_gc_mb_new();
+    }
+    t->satb->buffer[(t->satb->fill)++] = cell;
+    if(unlikely((GLAS_GC_CELL_BUFFSZ == t->satb->fill) || 
+                (GLAS_OS_THREAD_BUSY != t->state))) 
+    {
+        glas_os_thread_satb_flush(t);
+    }
 }
 LOCAL inline void glas_wb_snapshot_sched(glas_cell* cell) {
     if(GLAS_DATA_IS_PTR(cell) && glas_gc_try_cell_mark(cell)) {
@@ -1726,6 +2675,7 @@ LOCAL inline void glas_wb_snapshot_sched(glas_cell* cell) {
     }
 }
 LOCAL inline void glas_roots_slot_write(glas_roots* roots, glas_cell** slot, glas_cell* new_val) {
+    // no card: roots are fully traced in every cycle, minor or full
     if(glas_rt.gc.marking) {
         glas_cell* const prior_val = (*slot);
         if(glas_wb_claim_roots_slot(roots, slot)) {
@@ -1734,6 +2684,25 @@ LOCAL inline void glas_roots_slot_write(glas_roots* roots, glas_cell** slot, gla
     }
     (*slot) = new_val;
 }
+LOCAL inline void glas_stack_slot_write(glas_roots* roots, glas_cell** slot, glas_cell* new_val) {
+    // stack and stash slots, including overflow
+  #if GLAS_GC_EAGER_STACKS
+    (void)roots; // shaded at mark start
+    (*slot) = new_val;
+  #else
+    glas_roots_slot_write(roots, slot, new_val);
+  #endif
+}
+LOCAL inline void glas_page_card_dirty(glas_cell* cell) {
+    // record a potential old-to-young pointer for minor GC
+    glas_page* const page = glas_page_from_internal_addr(cell);
+    size_t const card = glas_mem_card_index(cell);
+    _Atomic(uint64_t)* const pcards = page->cards + (card / 64);
+    uint64_t const bit = UINT64_C(1) << (card % 64);
+    if(0 == (bit & atomic_load_explicit(pcards, memory_order_relaxed))) {
+        atomic_fetch_or_explicit(pcards, bit, memory_order_relaxed);
+    }
+}
 LOCAL inline void glas_cell_slot_write(glas_cell* dst, glas_cell** slot, glas_cell* new_val) {
     if(glas_rt.gc.marking) {
         glas_cell* const prior_val = (*slot);
@@ -1742,12 +2711,15 @@ LOCAL inline void glas_cell_slot_write(glas_cell* dst, glas_cell** slot, glas_ce
         }
     }
     (*slot) = new_val;
+    if(GLAS_DATA_IS_PTR(new_val)) {
+        glas_page_card_dirty(dst);
+    }
 }
-LOCAL void glas_gc_dq_push(glas_gc_dq*, glas_refct);
-LOCAL void glas_cell_finalize(glas_cell* cell) {
+LOCAL void glas_gc_dq_push(glas_gc_dq*, glas_gc_db**, glas_refct);
+LOCAL void glas_cell_finalize(glas_cell* cell, glas_gc_db** batch) {
     glas_type_id const ty = cell->hdr.type_id;
     if(GLAS_TYPE_FOREIGN_PTR == ty) {
-        glas_gc_dq_push(&glas_rt.gc.dq, cell->foreign_ptr.pin);
+        glas_gc_dq_push(&glas_rt.gc.dq, batch, cell->foreign_ptr.pin);
         cell->foreign_ptr.pin.refct_upd = NULL;
     } else if(GLAS_TYPE_REFERENCE == ty) {
         atomic_store_explicit(&(cell->ref.ts->ts.wk), GLAS_VOID, memory_order_relaxed);
@@ -1766,6 +2738,11 @@ LOCAL inline bool glas_cell_is_linear(glas_cell* cell) {
  ***************************/
 LOCAL inline void glas_gc_mark_cell(glas_gc_mb** mb, glas_cell* cell) {
     if(GLAS_DATA_IS_PTR(cell) && glas_gc_try_cell_mark(cell)) {
+        if(atomic_load_explicit(&glas_rt.gc.prefetch, memory_order_relaxed)) {
+            // prefetch on push, as Boehm does. The mark word is already
+            // cached by try_cell_mark, and trace will update gcbits.
+            __builtin_prefetch(cell, 1, 3);
+        }
         glas_gc_mb_push(mb, cell);
     }
 }
@@ -1788,29 +2765,33 @@ LOCAL bool glas_gc_trace_find_work(glas_gc_mb** mbhead) {
         }
     }
 
-    // load from shared worklists if possible.
-    pthread_mutex_lock(&glas_rt.gc.gc_mb_pop_mutex); // lock to resist ABA problem
-    mb = atomic_load_explicit(&glas_rt.gc.mb, memory_order_acquire);
-    do {} while((NULL != mb) && !atomic_compare_exchange_weak_explicit(&glas_rt.gc.mb, 
-            &mb, mb->next, memory_order_acquire, memory_order_acquire));
-    pthread_mutex_unlock(&glas_rt.gc.gc_mb_pop_mutex);
+    // load from our deque, or steal from other GC threads
+    mb = glas_gc_deque_find_work();
     if(NULL != mb) {
+        assert(likely(NULL == mb->next));
         mb->next = (*mbhead);
         (*mbhead) = mb;
         return true;
     }
 
-    // fill from write barrier (cf glas_wb_snapshot_push)
-    static size_t const fill_goal = GLAS_GC_CELL_BUFFSZ/2;
-    glas_cell* wb = atomic_load_explicit(&glas_rt.gc.wb, memory_order_acquire);
-    while((GLAS_VOID != wb) && (fill_goal > (*mbhead)->fill)) {
-        if(atomic_compare_exchange_weak_explicit(&glas_rt.gc.wb, &wb, 
-            wb->small_arr[0], memory_order_acquire, memory_order_acquire))
-        {
-            (*mbhead)->buffer[((*mbhead)->fill)++] = wb->small_arr[1];
-        }
+    // take all buffers flushed from write barriers, share extras
+    // (cf glas_os_thread_satb_flush)
+    if(NULL == atomic_load_explicit(&glas_rt.gc.satb, memory_order_relaxed)) {
+        return false;
+    }
+    mb = atomic_exchange_explicit(&glas_rt.gc.satb, NULL, memory_order_acquire);
+    if(NULL == mb) {
+        return false;
+    }
+    while(NULL != mb->next) {
+        glas_gc_mb* const extra = mb->next;
+        mb->next = extra->next;
+        extra->next = NULL;
+        glas_gc_deque_share(extra);
     }
-    return (0 < (*mbhead)->fill);
+    mb->next = (*mbhead);
+    (*mbhead) = mb;
+    return true;
 }
 LOCAL void glas_gc_trace_array(glas_gc_mb** mb, glas_cell** data, size_t len) {
     // Use dedicated slot for lazy processing of data arrays. But there
@@ -1846,20 +2827,8 @@ LOCAL inline bool glas_cell_is_dead_tombstone(glas_cell* cell) {
             (GLAS_TYPE_TOMBSTONE == cell->hdr.type_id) && 
             (GLAS_VOID == cell->ts.wk));
 }
-LOCAL void glas_gc_trace_cell(glas_gc_mb** mb, glas_cell* cell) {
-    static_assert(sizeof(glas_cell*) == sizeof(_Atomic(glas_cell*)));
-    static_assert(8 == sizeof(glas_cell*));
-    glas_cell const cpy = (*cell); // claim snapshot
-    uint8_t claim; // slots not already claimed by write barrier
-    if(glas_gc_b0scan()) {
-        uint8_t const prior = atomic_fetch_and_explicit(&(cell->hdr.gcbits), 
-            ~(GLAS_GCBITS_SCAN), memory_order_release);
-        claim = GLAS_GCBITS_SCAN & prior; // prior 1 bit is claimed
-    } else {
-        uint8_t const prior = atomic_fetch_or_explicit(&(cell->hdr.gcbits), 
-            GLAS_GCBITS_SCAN, memory_order_release);
-        claim = GLAS_GCBITS_SCAN & ~prior; // prior 0 bit is claimed
-    }
+LOCAL void glas_gc_trace_cell_slots(glas_gc_mb** mb, glas_cell* cell, glas_cell const cpy, uint8_t claim) {
+    // mark claimed slots from snapshot `cpy` of cell
     #define GLAS_CELL_SLOT_INDEX(Field)     ((offsetof(glas_cell, Field)/sizeof(glas_cell*))-1)
     #define GLAS_CELL_SLOT_CLAIMED(Field)   (0 != (claim & (1 << GLAS_CELL_SLOT_INDEX(Field))))
     #define GLAS_CELL_SLOT_MARK(Field)\
@@ -1879,6 +2848,10 @@ LOCAL void glas_gc_trace_cell(glas_gc_mb** mb, glas_cell* cell) {
         case GLAS_TYPE_STEM:
             GLAS_CELL_SLOT_MARK(stem.fby);
             return;
+        case GLAS_TYPE_STEM_OF_BIN:
+            GLAS_CELL_SLOT_MARK(stem_of_bin.binary);
+            GLAS_CELL_SLOT_MARK(stem_of_bin.fby);
+            return;
         case GLAS_TYPE_SMALL_ARR:
             GLAS_CELL_SLOT_MARK(small_arr[0]);
             GLAS_CELL_SLOT_MARK(small_arr[1]);
@@ -1891,6 +2864,9 @@ LOCAL void glas_gc_trace_cell(glas_gc_mb** mb, glas_cell* cell) {
         case GLAS_TYPE_BIG_BIN:
             GLAS_CELL_SLOT_MARK(big_bin.fptr);
             return;
+        case GLAS_TYPE_INT_ARR:
+            GLAS_CELL_SLOT_MARK(int_arr.fptr);
+            return;
         case GLAS_TYPE_EXTREF:
             GLAS_CELL_SLOT_MARK(extref.ref);
             GLAS_CELL_SLOT_MARK(extref.ts);
@@ -1933,10 +2909,95 @@ LOCAL void glas_gc_trace_cell(glas_gc_mb** mb, glas_cell* cell) {
     debug("unhandled cell type: %d", (int) cell->hdr.type_id);
     abort();
 }
-LOCAL inline void glas_gc_trace_marked_cells(glas_gc_mb** mb) {
+LOCAL void glas_gc_trace_cell(glas_gc_mb** mb, glas_cell* cell) {
+    static_assert(sizeof(glas_cell*) == sizeof(_Atomic(glas_cell*)));
+    static_assert(8 == sizeof(glas_cell*));
+    glas_cell const cpy = (*cell); // claim snapshot
+    uint8_t claim; // slots not already claimed by write barrier
+    if(glas_gc_b0scan()) {
+        uint8_t const prior = atomic_fetch_and_explicit(&(cell->hdr.gcbits), 
+            ~(GLAS_GCBITS_SCAN), memory_order_release);
+        claim = GLAS_GCBITS_SCAN & prior; // prior 1 bit is claimed
+    } else {
+        uint8_t const prior = atomic_fetch_or_explicit(&(cell->hdr.gcbits), 
+            GLAS_GCBITS_SCAN, memory_order_release);
+        claim = GLAS_GCBITS_SCAN & ~prior; // prior 0 bit is claimed
+    }
+    glas_gc_trace_cell_slots(mb, cell, cpy, claim);
+}
+/**
+ * Minor GC treats cells marked in a prior cycle as old, and won't trace
+ * them. But old cells may be updated to reference young cells. We scan
+ * old cells in dirty cards while the world is stopped, so we don't need
+ * write barriers to cooperate, then clear the cards.
+ */
+LOCAL void glas_gc_trace_dirty_cards(glas_gc_mb** mb, glas_page* page) {
+    static size_t const card_cells = GLAS_HEAP_CARD_SIZE / GLAS_CELL_SIZE;
+    size_t const stride = ((size_t)1) << page->size_class;
+    for(size_t w = 0; w < (GLAS_PAGE_CARD_COUNT/64); ++w) {
+        uint64_t dirty = atomic_exchange_explicit(page->cards + w, 0, memory_order_relaxed);
+        while(0 != dirty) {
+            size_t const card = (w * 64) + ctz64(dirty);
+            dirty &= (dirty - 1);
+            for(size_t ix = card * card_cells; ix < ((card + 1) * card_cells); ++ix) {
+                if(0 != (ix % stride)) { continue; } // not an object header
+                uint64_t const old = atomic_load_explicit(page->marked + (ix / 64), memory_order_relaxed);
+                if(0 != (old & (UINT64_C(1) << (ix % 64)))) {
+                    glas_cell* const cell = ((glas_cell*)page) + ix;
+                    glas_gc_trace_cell_slots(mb, cell, (*cell), GLAS_GCBITS_SCAN);
+                }
+            }
+        }
+    }
+}
+LOCAL size_t glas_gc_trace_marked_cells_lifo(glas_gc_mb** mb) {
+    size_t traced = 0;
     do {
         if(0 < (*mb)->fill) {
             glas_gc_trace_cell(mb, (*mb)->buffer[--((*mb)->fill)]);
+            ++traced;
+        } else if(0 < (*mb)->arr.len) {
+            // lazy tracing for arrays            
+            glas_gc_mark_cell(mb, (*mb)->arr.data[--((*mb)->arr.len)]);
+        } else if(!glas_gc_trace_find_work(mb)) {
+            break;
+        }
+    } while(1);
+    return traced;
+}
+LOCAL size_t glas_gc_trace_marked_cells_prefetch(glas_gc_mb** mb) {
+    // Cells pass from the mark buffer through a small FIFO ring, so a
+    // cell prefetched on push is likely cached by the time we trace it.
+    // We prefetch again on entry for cells pushed long ago or by other
+    // threads. The ring is private, but it's drained before we seek work.
+    glas_cell* ring[GLAS_GC_PREFETCH_DIST];
+    size_t head = 0;
+    size_t count = 0;
+    size_t traced = 0;
+    uintptr_t last = 0;
+    do {
+        if((0 < (*mb)->fill) && 
+           ((((uintptr_t)(*mb)->buffer[(*mb)->fill - 1]) - last + GLAS_GC_PREFETCH_NEAR) 
+                <= (2 * GLAS_GC_PREFETCH_NEAR))) 
+        {
+            // near the cell we just traced, e.g. down a list allocated in
+            // order, so hardware prefetch serves it better than the ring
+            glas_cell* const cell = (*mb)->buffer[--((*mb)->fill)];
+            last = (uintptr_t) cell;
+            glas_gc_trace_cell(mb, cell);
+            ++traced;
+        } else if((GLAS_GC_PREFETCH_DIST > count) && (0 < (*mb)->fill)) {
+            glas_cell* const cell = (*mb)->buffer[--((*mb)->fill)];
+            __builtin_prefetch(cell, 1, 3);
+            ring[(head + count) % GLAS_GC_PREFETCH_DIST] = cell;
+            ++count;
+        } else if(0 < count) {
+            glas_cell* const cell = ring[head];
+            head = (head + 1) % GLAS_GC_PREFETCH_DIST;
+            --count;
+            last = (uintptr_t) cell;
+            glas_gc_trace_cell(mb, cell);
+            ++traced;
         } else if(0 < (*mb)->arr.len) {
             // lazy tracing for arrays            
             glas_gc_mark_cell(mb, (*mb)->arr.data[--((*mb)->arr.len)]);
@@ -1944,6 +3005,14 @@ LOCAL inline void glas_gc_trace_marked_cells(glas_gc_mb** mb) {
             break;
         }
     } while(1);
+    return traced;
+}
+LOCAL inline void glas_gc_trace_marked_cells(glas_gc_mb** mb) {
+    size_t const traced = atomic_load_explicit(&glas_rt.gc.prefetch, memory_order_relaxed) ?
+        glas_gc_trace_marked_cells_prefetch(mb) : glas_gc_trace_marked_cells_lifo(mb);
+    if(0 < traced) {
+        atomic_fetch_add_explicit(&glas_rt.stat.gc_mark_cells, traced, memory_order_relaxed);
+    }
 }
 LOCAL void glas_gc_trace_roots(glas_gc_mb** mb, glas_roots* r) {
     glas_cell** const base = (glas_cell**) r->self;
@@ -1968,7 +3037,7 @@ LOCAL void glas_gc_trace_roots(glas_gc_mb** mb, glas_roots* r) {
         assert(likely(count > 0));
         // atomic claim for bitmap (racing with write barriers)
         uint64_t claimed;
-        if(glas_gc_b0scan()) { // 0 bit means 'scanned' this phase.
+        if(glas_gc_roots_b0scan()) { // 0 bit means 'scanned' this phase.
             uint64_t const prior = atomic_fetch_and_explicit((r->slot_bitmap + bitmap_ix), ~bitmask, memory_order_release);
             claimed = bitmask & prior; // prior 1 bit is unscanned
         } else {
@@ -1986,6 +3055,22 @@ LOCAL void glas_gc_trace_roots(glas_gc_mb** mb, glas_roots* r) {
         glas_gc_trace_marked_cells(mb);
     }
 }
+LOCAL void glas_gc_shade_eager_roots(glas_gc_mb** mb, glas_roots* r) {
+    // claim and shade eager roots while the world is stopped
+    glas_cell** const base = (glas_cell**) r->self;
+    bool const b0scan = glas_gc_roots_b0scan(); // 0 bit means 'scanned'
+    for(size_t ix = 0; ix < r->eager_count; ++ix) {
+        uint16_t const offset = r->roots[ix];
+        _Atomic(uint64_t)* const pbitmap = r->slot_bitmap + (offset / 64);
+        uint64_t const bit = UINT64_C(1) << (offset % 64);
+        if(b0scan) {
+            atomic_fetch_and_explicit(pbitmap, ~bit, memory_order_relaxed);
+        } else {
+            atomic_fetch_or_explicit(pbitmap, bit, memory_order_relaxed);
+        }
+        glas_gc_mark_cell(mb, base[offset]);
+    }
+}
 LOCAL void glas_gc_thread_stripe_trace(glas_gc_mb** mb) {
     // all threads scan same list, but race to claim roots and begin tracing.
     uint64_t const cycle = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
@@ -1999,53 +3084,121 @@ LOCAL void glas_gc_thread_stripe_trace(glas_gc_mb** mb) {
         }
     }
 }
-LOCAL bool glas_gc_thread_try_finalize_cell(glas_cell* cell) {
-    glas_page* const page = glas_page_from_internal_addr(cell);
-    size_t const coff = cell - ((glas_cell*)page);
-    uint64_t const bitmap = atomic_load_explicit(page->marked + (coff/64), memory_order_relaxed);
-    uint64_t bit = UINT64_C(1) << (coff%64);
-    if(0 != (bit & bitmap)) {
-        return false; // marked
+LOCAL void glas_gc_fin_fold(glas_gc_fl* fl) {
+    // move finalizers registered before this cycle into page cards
+    while(NULL != fl) {
+        for(size_t ix = 0; ix < fl->fill; ++ix) {
+            glas_cell* const cell = fl->buffer[ix];
+            glas_page* const page = glas_page_from_internal_addr(cell);
+            size_t const card = (((uintptr_t)cell) - ((uintptr_t)page)) >> GLAS_HEAP_CARD_SIZE_LG2;
+            atomic_fetch_or_explicit(page->fcards + (card / 64), 
+                (UINT64_C(1) << (card % 64)), memory_order_relaxed);
+            page->fin = true;
+        }
+        glas_gc_fl* const tmp = fl;
+        fl = fl->next;
+        free(tmp);
     }
-    glas_cell_finalize(cell);
-    return true;
 }
-LOCAL void glas_gc_thread_run_finalizers(glas_gc_fl* const fl_start) {
-    glas_gc_fl* fl = fl_start;
-    while(NULL != fl) {
-        size_t ix = 0;
-        while(ix < fl->fill) {
-            bool const finalized = glas_gc_thread_try_finalize_cell(fl->buffer[ix]);
-            if(finalized) {
-                fl->buffer[ix] = fl->buffer[--(fl->fill)];
-            } else {
-                ++ix;
+LOCAL void glas_gc_page_run_finalizers(glas_page* page, glas_gc_db** batch) {
+    // Finalize unmarked cells in finalizer cards. Live cells aren't read.
+    // Cards without marked cells are cleared. Cards with live cells are
+    // kept, even if the live cells aren't finalizers.
+    bool fin = false;
+    for(size_t w = 0; w < (GLAS_PAGE_CARD_COUNT/64); ++w) {
+        uint64_t const fcards = atomic_load_explicit(page->fcards + w, memory_order_relaxed);
+        if(0 == fcards) { continue; }
+        uint64_t keep = 0;
+        for(size_t q = 0; q < 4; ++q) {
+            size_t const mark_word = (4 * w) + q;
+            uint64_t const cells = glas_card_bits_to_cells(fcards >> (16 * q));
+            if(0 == cells) { continue; }
+            uint64_t const marked = atomic_load_explicit(page->marked + mark_word, memory_order_relaxed);
+            uint64_t dead = cells & ~marked;
+            while(0 != dead) {
+                glas_cell* const cell = ((glas_cell*)page) + (64 * mark_word) + ctz64(dead);
+                dead &= (dead - 1);
+                uint8_t const prior = atomic_fetch_and_explicit(&(cell->hdr.gcbits), 
+                    (uint8_t)~GLAS_GCBITS_FIN, memory_order_relaxed);
+                if(0 != (GLAS_GCBITS_FIN & prior)) {
+                    glas_cell_finalize(cell, batch);
+                }
             }
+            keep |= glas_cell_bits_to_cards(cells & marked) << (16 * q);
+        }
+        if(keep != fcards) {
+            atomic_store_explicit(page->fcards + w, keep, memory_order_relaxed);
+        }
+        fin = fin || (0 != keep);
+    }
+    page->fin = fin;
+}
+LOCAL void glas_gc_dq_flush(glas_gc_dq* dq, glas_gc_db** batch);
+LOCAL void glas_gc_thread_run_finalizers() {
+    // Any GC thread. Claim pages flagged 'fin_pending' in the final stop.
+    // The list isn't extended during the pass, so there is no ABA.
+    glas_gc_db* batch = NULL;
+    size_t count = 0;
+    glas_page* page = atomic_load_explicit(&glas_rt.gc.fin_pages, memory_order_acquire);
+    while(NULL != page) {
+        if(atomic_compare_exchange_weak_explicit(&glas_rt.gc.fin_pages, &page, page->fin_next,
+            memory_order_acq_rel, memory_order_acquire))
+        {
+            glas_gc_page_run_finalizers(page, &batch);
+            atomic_store_explicit(&(page->fin_pending), false, memory_order_release);
+            ++count;
+            page = atomic_load_explicit(&glas_rt.gc.fin_pages, memory_order_acquire);
         }
-        fl = fl->next;
     }
-    glas_gc_fl_compact(fl_start);
+    glas_gc_dq_flush(&glas_rt.gc.dq, &batch);
+    if(0 < count) {
+        atomic_fetch_add_explicit(&glas_rt.stat.gc_fin_pages, count, memory_order_relaxed);
+    }
 }
 
+LOCAL bool glas_gc_work_is_visible() {
+    return (NULL != atomic_load_explicit(&glas_rt.gc.satb, memory_order_relaxed)) ||
+           !glas_gc_deques_are_empty();
+}
+LOCAL bool glas_gc_trace_await_work(glas_gc_mb** mb) {
+    // Termination detection for workers. An idle worker withdraws from
+    // the active count. A worker holding private mark buffers remains 
+    // active and may still share work, so idle workers give up only when
+    // no worker is active and no shared work is visible. The main GC 
+    // thread handles whatever remains, including late write barriers.
+    atomic_fetch_sub_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+    do {
+        if(glas_gc_work_is_visible()) {
+            atomic_fetch_add_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+            if(glas_gc_trace_find_work(mb)) {
+                return true;
+            }
+            atomic_fetch_sub_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+        } else if(0 == atomic_load_explicit(&glas_rt.gc.pool.active, memory_order_acquire)) {
+            return false;
+        }
+        sched_yield();
+    } while(1);
+}
 LOCAL void* glas_gc_worker_thread(void* arg) {
-    (void)arg;
+    // created active, during marking (cf glas_gc_workers_spawn). Parked
+    // workers are also woken to share the finalizer pass after marking.
+    pthread_setspecific(glas_rt.gc.pool.deque_key, arg);
     glas_gc_mb* mb = glas_gc_mb_new();
     do {
-        assert(likely(glas_gc_mb_is_empty(mb) && (NULL == mb->next)));
-        atomic_fetch_add_explicit(&glas_rt.gc.pool.done, 1, memory_order_release);
-        sem_wait(&glas_rt.gc.pool.wakeup);
-        assert(likely(glas_rt.gc.marking));
-        glas_gc_thread_stripe_trace(&mb);
-        size_t idle = 0; 
-        do {
-            sched_yield();
-            if(glas_gc_trace_find_work(&mb)) {
+        if(glas_rt.gc.marking) {
+            glas_gc_thread_stripe_trace(&mb);
+            do {
                 glas_gc_trace_marked_cells(&mb);
-            } else {
-                ++idle;
-            }
-        } while(idle < GLAS_GC_THREAD_IDLE_CYCLES);
-        assert(likely(glas_rt.gc.marking));
+            } while(glas_gc_trace_await_work(&mb));
+            assert(likely(glas_rt.gc.marking));
+            assert(likely(glas_gc_mb_is_empty(mb) && (NULL == mb->next)));
+        } else {
+            glas_gc_thread_run_finalizers();
+            atomic_fetch_sub_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+        }
+        atomic_fetch_add_explicit(&glas_rt.gc.pool.parked, 1, memory_order_release);
+        sem_wait(&glas_rt.gc.pool.wakeup);
     } while(1);
     __builtin_unreachable();
 }
@@ -2053,9 +3206,9 @@ LOCAL void* glas_gc_worker_thread(void* arg) {
 static inline size_t num_cpus() {
     return sysconf(_SC_NPROCESSORS_ONLN);
 }
-LOCAL size_t glas_gc_decide_worker_count() {
+LOCAL size_t glas_gc_decide_worker_max() {
     size_t const ncpus = num_cpus();
-    size_t gc_thread_count = 1 + (ncpus/2); // includes main gc thread
+    size_t gc_thread_count = ncpus; // includes main gc thread
     if(gc_thread_count > GLAS_GC_THREADS_MAX) {
         gc_thread_count = GLAS_GC_THREADS_MAX;
     }
@@ -2071,146 +3224,276 @@ LOCAL size_t glas_gc_decide_worker_count() {
             gc_thread_count = n;
         }
     }
-    assert(likely(gc_thread_count > 0));
+    if(gc_thread_count < 1) {
+        gc_thread_count = 1;
+    }
     return (gc_thread_count - 1); // not counting main GC thread
 }
+LOCAL size_t glas_gc_heuristic_worker_count(size_t work_pages, size_t max) {
+    // workers to wake at start of marking; small heaps need none
+    size_t const n = work_pages / GLAS_GC_WORKER_PAGES;
+    return (n < max) ? n : max;
+}
 LOCAL inline bool glas_gc_workers_are_done() {
-    return (glas_rt.gc.pool.count == 
-                atomic_load_explicit(&glas_rt.gc.pool.done, memory_order_acquire));
+    return (atomic_load_explicit(&glas_rt.gc.pool.count, memory_order_acquire) == 
+            atomic_load_explicit(&glas_rt.gc.pool.parked, memory_order_acquire));
+}
+LOCAL bool glas_gc_workers_wake_one() {
+    atomic_fetch_add_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+    size_t parked = atomic_load_explicit(&glas_rt.gc.pool.parked, memory_order_acquire);
+    while(0 < parked) {
+        if(atomic_compare_exchange_weak_explicit(&glas_rt.gc.pool.parked, &parked, (parked - 1),
+            memory_order_acq_rel, memory_order_acquire))
+        {
+            sem_post(&glas_rt.gc.pool.wakeup);
+            return true;
+        }
+    }
+    atomic_fetch_sub_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+    return false;
 }
-LOCAL inline void glas_gc_workers_signal() {
-    assert(likely(glas_gc_workers_are_done()));
-    atomic_store_explicit(&glas_rt.gc.pool.done, 0, memory_order_relaxed);
-    for(size_t ix = 0; ix < glas_rt.gc.pool.count; ++ix) {
-        sem_post(&glas_rt.gc.pool.wakeup);
+LOCAL void glas_gc_workers_wake_backlog() {
+    // any GC thread; creating workers is left to the main GC thread
+    if(!atomic_load_explicit(&glas_rt.gc.pool.open, memory_order_acquire)) {
+        return; 
+    }
+    if(!glas_gc_workers_wake_one() && 
+       (atomic_load_explicit(&glas_rt.gc.pool.count, memory_order_relaxed) < glas_rt.gc.pool.max)) 
+    {
+        atomic_store_explicit(&glas_rt.gc.pool.grow, true, memory_order_relaxed);
     }
 }
-LOCAL void glas_gc_workers_init() {
-    atomic_init(&glas_rt.gc.pool.done, 0);
-    sem_init(&glas_rt.gc.pool.wakeup,0,0);
-    glas_rt.gc.pool.count = glas_gc_decide_worker_count();
-    if(0 == glas_rt.gc.pool.count) {
-        return;
+LOCAL bool glas_gc_workers_spawn() {
+    // main GC thread only, while marking or running finalizers
+    size_t const ix = atomic_load_explicit(&glas_rt.gc.pool.count, memory_order_relaxed);
+    if(ix >= glas_rt.gc.pool.max) {
+        return false;
     }
-    glas_rt.gc.pool.workers = calloc(glas_rt.gc.pool.count, sizeof(pthread_t));
     pthread_attr_t gc_worker_attr;
     pthread_attr_init(&gc_worker_attr);
     pthread_attr_setscope(&gc_worker_attr, PTHREAD_SCOPE_PROCESS);
     pthread_attr_setdetachstate(&gc_worker_attr, PTHREAD_CREATE_DETACHED);
     pthread_attr_setstacksize(&gc_worker_attr, (7 * 4096)); // small stack 
     pthread_attr_setguardsize(&gc_worker_attr, (1 * 4096));
-    for(size_t ix = 0; ix < glas_rt.gc.pool.count; ++ix) {
-        pthread_create((glas_rt.gc.pool.workers + ix), &gc_worker_attr,
-            &glas_gc_worker_thread, NULL);
-    }
+    atomic_fetch_add_explicit(&glas_rt.gc.pool.active, 1, memory_order_acq_rel);
+    atomic_store_explicit(&glas_rt.gc.pool.count, (ix + 1), memory_order_release);
+    pthread_create((glas_rt.gc.pool.workers + ix), &gc_worker_attr,
+        &glas_gc_worker_thread, (glas_rt.gc.pool.deques + 1 + ix));
     pthread_attr_destroy(&gc_worker_attr);
-
-    // wait for GC workers to be ready
-    while(!glas_gc_workers_are_done()) {
-        sched_yield();
-    }
-}
-
-
-LOCAL inline bool glas_gc_dq_is_full(glas_gc_dq const* dq) {
-    return ((dq->tail + 1) % dq->capacity) == dq->head;
-}
-LOCAL inline bool glas_gc_dq_is_empty(glas_gc_dq const* dq) {
-    return (dq->tail == dq->head);
+    return true;
 }
-LOCAL inline size_t glas_gc_dq_size(glas_gc_dq const* dq) {
-    return (dq->tail >= dq->head) ? (dq->tail - dq->head) :
-            (dq->capacity - (dq->head - dq->tail));
+LOCAL void glas_gc_workers_grow() {
+    // main GC thread, while marking; respond to backlog
+    if(atomic_exchange_explicit(&glas_rt.gc.pool.grow, false, memory_order_relaxed) &&
+       !glas_gc_workers_wake_one()) 
+    {
+        (void) glas_gc_workers_spawn();
+    }
 }
-LOCAL void glas_gc_dq_grow(glas_gc_dq* dq, size_t new_cap) {
-    assert(likely(new_cap > glas_gc_dq_size(dq)));
-    //debug("growing decref queue: %lu -> %lu", dq->capacity, new_cap);
-    glas_refct* const new_items = malloc(new_cap * sizeof(glas_refct));
-    size_t new_tail = 0;
-    while(dq->head != dq->tail) {
-        new_items[new_tail++] = dq->items[dq->head];
-        dq->head = (dq->head + 1) % dq->capacity;
+LOCAL void glas_gc_workers_signal(size_t work_pages) {
+    assert(likely(glas_gc_workers_are_done()));
+    assert(likely(0 == atomic_load_explicit(&glas_rt.gc.pool.active, memory_order_relaxed)));
+    atomic_store_explicit(&glas_rt.gc.pool.grow, false, memory_order_relaxed);
+    atomic_store_explicit(&glas_rt.gc.pool.open, true, memory_order_release);
+    size_t const n = glas_gc_heuristic_worker_count(work_pages, glas_rt.gc.pool.max);
+    for(size_t ix = 0; ix < n; ++ix) {
+        if(!glas_gc_workers_wake_one() && !glas_gc_workers_spawn()) {
+            break;
+        }
     }
-    free(dq->items);
-    dq->items = new_items;
-    dq->capacity = new_cap;
-    dq->tail = new_tail;
-    dq->head = 0;
 }
-LOCAL void glas_gc_dq_push(glas_gc_dq* dq, glas_refct refct) {
-    pthread_mutex_lock(&dq->mutex);
-    bool const send_wakeup = glas_gc_dq_is_empty(dq);
-    if(glas_gc_dq_is_full(dq)) {
-        glas_gc_dq_grow(dq, 2 * dq->capacity);
+LOCAL void glas_gc_run_finalizers(size_t page_count) {
+    // main GC thread, after marking. A page may hold thousands of 
+    // finalizers, so wake (or create) a worker per flagged page beyond
+    // our own, take a share, then wait for workers to park.
+    size_t const want = (page_count > 1) ? (page_count - 1) : 0;
+    size_t const n = (want < glas_rt.gc.pool.max) ? want : glas_rt.gc.pool.max;
+    for(size_t ix = 0; ix < n; ++ix) {
+        if(!glas_gc_workers_wake_one() && !glas_gc_workers_spawn()) {
+            break;
+        }
     }
-    dq->items[dq->tail] = refct;
-    dq->tail = (dq->tail + 1) % dq->capacity;
-    pthread_mutex_unlock(&glas_rt.gc.dq.mutex);
-    if(send_wakeup) {
-        sem_post(&dq->wakeup);
+    glas_gc_thread_run_finalizers();
+    while(!glas_gc_workers_are_done()) {
+        sched_yield();
     }
 }
-LOCAL bool glas_gc_dq_pop(glas_gc_dq* dq, glas_refct* refct) {
-    pthread_mutex_lock(&dq->mutex);
-    bool const item_found = !glas_gc_dq_is_empty(dq);
-    if(item_found) {
-        (*refct) = dq->items[dq->head];
-        dq->head = (dq->head + 1) % dq->capacity;
-    } else {
-        refct->refct_upd = NULL;
+LOCAL void glas_gc_workers_init() {
+    atomic_init(&glas_rt.gc.pool.count, 0);
+    atomic_init(&glas_rt.gc.pool.parked, 0);
+    atomic_init(&glas_rt.gc.pool.active, 0);
+    atomic_init(&glas_rt.gc.pool.grow, false);
+    atomic_init(&glas_rt.gc.pool.open, false);
+    sem_init(&glas_rt.gc.pool.wakeup,0,0);
+    glas_rt.gc.pool.max = glas_gc_decide_worker_max();
+    glas_rt.gc.pool.workers = calloc((1 + glas_rt.gc.pool.max), sizeof(pthread_t));
+
+    // one deque per GC thread, including main GC thread at index 0
+    size_t const deques_size = (1 + glas_rt.gc.pool.max) * sizeof(glas_gc_deque);
+    glas_rt.gc.pool.deques = aligned_alloc(64, deques_size);
+    assert(likely(NULL != glas_rt.gc.pool.deques));
+    for(size_t ix = 0; ix <= glas_rt.gc.pool.max; ++ix) {
+        glas_gc_deque_init(glas_rt.gc.pool.deques + ix, 
+            (UINT64_C(0x9E3779B97F4A7C15) * (1 + ix)));
+    }
+    pthread_key_create(&glas_rt.gc.pool.deque_key, NULL);
+    pthread_setspecific(glas_rt.gc.pool.deque_key, glas_rt.gc.pool.deques);
+}
+
+
+LOCAL inline bool glas_gc_dq_is_runtime_owned(glas_refct refct) {
+    return (glas_cell_binary_refct_upd == refct.refct_upd) ||
+           (glas_cell_array_free == refct.refct_upd);
+}
+LOCAL void glas_gc_dq_flush(glas_gc_dq* dq, glas_gc_db** batch) {
+    // hand off a GC thread's batch
+    glas_gc_db* const db = (*batch);
+    if(NULL == db) { return; }
+    (*batch) = NULL;
+    size_t const next = atomic_fetch_add_explicit(&(dq->next), 1, memory_order_relaxed);
+    glas_gc_dqw* const w = dq->workers + (next % dq->count);
+    atomic_fetch_add_explicit(&glas_rt.stat.decref_queued, db->fill, memory_order_relaxed);
+    atomic_pushlist(&(w->inbox), &(db->next), db);
+    sem_post(&(w->wakeup));
+}
+LOCAL void glas_gc_dq_push(glas_gc_dq* dq, glas_gc_db** batch, glas_refct refct) {
+    if(glas_gc_dq_is_runtime_owned(refct)) {
+        // no client code involved, cheaper than a handoff
+        glas_decref(refct);
+        atomic_fetch_add_explicit(&glas_rt.stat.decref_inline, 1, memory_order_relaxed);
+        return;
+    }
+    if(NULL == (*batch)) {
+        (*batch) = malloc(sizeof(glas_gc_db));
+        (*batch)->next = NULL;
+        (*batch)->fill = 0;
+    }
+    (*batch)->items[(*batch)->fill++] = refct;
+    if(GLAS_GC_DECREF_BATCH == (*batch)->fill) {
+        glas_gc_dq_flush(dq, batch);
     }
-    pthread_mutex_unlock(&dq->mutex);
-    return item_found;
 }
 LOCAL void* glas_gc_dq_worker(void* addr) {
-    glas_gc_dq* const dq = addr;
+    glas_gc_dqw* const w = addr;
     do {
-        sem_wait(&dq->wakeup);
-        glas_refct refct;
-        while(glas_gc_dq_pop(dq, &refct)) {
-            glas_decref(refct);
+        sem_wait(&(w->wakeup));
+        glas_gc_db* db = atomic_exchange_explicit(&(w->inbox), NULL, memory_order_acquire);
+        // inbox is LIFO; reverse to process batches in handoff order
+        glas_gc_db* fifo = NULL;
+        while(NULL != db) {
+            glas_gc_db* const next = db->next;
+            db->next = fifo;
+            fifo = db;
+            db = next;
+        }
+        while(NULL != fifo) {
+            glas_gc_db* const next = fifo->next;
+            for(size_t ix = 0; ix < fifo->fill; ++ix) {
+                glas_decref(fifo->items[ix]);
+            }
+            free(fifo);
+            fifo = next;
         }
+        // extra posts for batches taken early just find an empty inbox
     } while(1);
     __builtin_unreachable();
 }
+LOCAL size_t glas_gc_dq_decide_worker_count() {
+    size_t count = GLAS_GC_DECREF_THREADS;
+    char const* const env_decref_threads = getenv("GLAS_GC_DECREF_THREADS");
+    if(NULL != env_decref_threads) {
+        int const n = atoi(env_decref_threads);
+        if((n < 1) || (n > GLAS_GC_DECREF_THREADS_MAX)) {
+            debug("invalid value: GLAS_GC_DECREF_THREADS=%s", env_decref_threads);
+        } else {
+            count = n;
+        }
+    }
+    if(count < 1) { count = 1; }
+    if(count > GLAS_GC_DECREF_THREADS_MAX) { count = GLAS_GC_DECREF_THREADS_MAX; }
+    return count;
+}
 LOCAL void glas_gc_dq_init(glas_gc_dq* dq) {
-    pthread_mutex_init(&dq->mutex, NULL);
-    sem_init(&dq->wakeup, 0, 0);
-    dq->capacity = 1; // forces growth
-    dq->items = NULL;
-    dq->head = 0;
-    dq->tail = 0;
-    #ifndef DEBUG
-    glas_gc_dq_grow(dq, 2048); // larger initial size
-    #endif
-    // note: I don't want a small stack in this case because I don't
-    // know what insane things the API client will do upon decref.
-    pthread_create(&dq->thread, NULL, &glas_gc_dq_worker, dq);
+    dq->count = glas_gc_dq_decide_worker_count();
+    dq->workers = aligned_alloc(64, dq->count * sizeof(glas_gc_dqw));
+    assert(likely(NULL != dq->workers));
+    atomic_init(&(dq->next), 0);
+    for(size_t ix = 0; ix < dq->count; ++ix) {
+        glas_gc_dqw* const w = dq->workers + ix;
+        atomic_init(&(w->inbox), NULL);
+        sem_init(&(w->wakeup), 0, 0);
+        // note: I don't want a small stack in this case because I don't
+        // know what insane things the API client will do upon decref.
+        pthread_create(&(w->thread), NULL, &glas_gc_dq_worker, w);
+    }
 }
 
 LOCAL bool glas_gc_heuristic_level() {
-    // At the moment, this is not a generational GC. So our only levels
-    // are full GC or skip GC. This might change later, of course.
+    // Decide whether to run a GC cycle. Whether the cycle is minor or full
+    // was already decided by the prior cycle (see glas_rt.gc.gcbits). If
+    // a full GC is requested while the next cycle is minor, we'll run the
+    // minor cycle then immediately follow with a full cycle.
     glas_gc_flags const flags = atomic_exchange_explicit(&glas_rt.gc.trigger_flags, 0, memory_order_relaxed);
-    if(0 != (GLAS_GC_FULL & flags)) {
+    if(0 != (GLAS_GC_COMPACT & flags)) {
+        glas_rt.gc.compact_requested = true;
+    }
+    if(0 != ((GLAS_GC_FULL | GLAS_GC_COMPACT) & flags)) {
+        glas_rt.gc.full_requested = !glas_rt.gc.next_full;
         return true; 
     }
+    if(glas_rt.gc.full_requested || (0 != (GLAS_GC_MINOR & flags))) {
+        return true; // follow up on a request
+    }
     size_t const curr_roots = atomic_load_explicit(&glas_rt.stat.roots_init, memory_order_relaxed);
-    size_t const curr_pages = atomic_load_explicit(&glas_rt.stat.page_release, memory_order_relaxed);
     static size_t const roots_gc_thresh = 1024;
-    static size_t const pages_gc_thresh = 32;
     if(curr_roots > (roots_gc_thresh + glas_rt.gc.prior_root_ct)) {
         return true; // need handle some external garbage
     }
-    if(curr_pages < (pages_gc_thresh + glas_rt.gc.prior_page_ct)) {
-        return false; // mutators are more or less idle
+    if(glas_rt_heap_pressure()) {
+        return true; // above high-water mark
+    }
+    return (atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed) >=
+            atomic_load_explicit(&glas_rt.gc.pacer.trigger_at, memory_order_relaxed));
+}
+LOCAL void glas_gc_pacer_init() {
+    glas_rt.gc.pacer.target_pct = GLAS_GC_TARGET_PCT;
+    char const* const env_glas_gc_target_pct = getenv("GLAS_GC_TARGET_PCT");
+    if(NULL != env_glas_gc_target_pct) {
+        int const n = atoi(env_glas_gc_target_pct);
+        if(n < 1) {
+            debug("invalid value: GLAS_GC_TARGET_PCT=%s", env_glas_gc_target_pct);
+        } else {
+            glas_rt.gc.pacer.target_pct = (uint64_t) n;
+        }
     }
-    size_t const avail_count = atomic_load_explicit(&glas_rt.alloc.avail.page_count, memory_order_relaxed);
-    size_t const await_count = atomic_load_explicit(&glas_rt.alloc.await.page_count, memory_order_relaxed);
-    if(avail_count > (await_count/3)) {
-        return false; // still have a lot of available pages
+    glas_rt.gc.pacer.live_pages = 0;
+    glas_rt.gc.pacer.cycle_start = 0;
+    glas_rt.gc.pacer.cycle_alloc = 0;
+    atomic_init(&glas_rt.gc.pacer.trigger_at, GLAS_GC_PACER_MIN_PAGES);
+}
+LOCAL void glas_gc_pacer_update(uint64_t live_cells) {
+    // called at end of cycle with live cells counted from marks
+    uint64_t const now = atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed);
+    uint64_t const live = (live_cells + GLAS_PAGE_CELL_COUNT - 1) / GLAS_PAGE_CELL_COUNT;
+    uint64_t const cycle_alloc = now - glas_rt.gc.pacer.cycle_start;
+    glas_rt.gc.pacer.live_pages = live;
+    glas_rt.gc.pacer.cycle_alloc = (glas_rt.gc.pacer.cycle_alloc + cycle_alloc) / 2;
+
+    // Start early to finish before the goal, but keep at least half the
+    // runway so bursts don't cause back-to-back cycles. 
+    uint64_t runway = (live * glas_rt.gc.pacer.target_pct) / 100;
+    if(runway < GLAS_GC_PACER_MIN_PAGES) {
+        runway = GLAS_GC_PACER_MIN_PAGES;
+    }
+    uint64_t lead = glas_rt.gc.pacer.cycle_alloc;
+    if(lead > (runway / 2)) {
+        lead = runway / 2;
+    }
+    atomic_store_explicit(&glas_rt.gc.pacer.trigger_at, (now + runway - lead), memory_order_relaxed);
+    // mutators may have passed the trigger while we computed it
+    if(atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed) >= (now + runway - lead)) {
+        atomic_store_explicit(&glas_rt.gc.trigger, true, memory_order_relaxed);
     }
-    return true;
 }
 LOCAL inline void glas_page_swap_marked_marking(glas_page* page) {
     _Atomic(uint64_t)* const tmp = page->marking;
@@ -2220,14 +3503,29 @@ LOCAL inline void glas_page_swap_marked_marking(glas_page* page) {
 LOCAL inline void glas_page_clear_marking(glas_page* page) {
     memset(page->marking, 0, GLAS_PAGE_CELL_COUNT/8);
 }
+LOCAL inline bool glas_page_is_owned(glas_page* page) {
+    return atomic_load_explicit(&(page->owned), memory_order_acquire);
+}
 LOCAL inline bool glas_gc_heuristic_decide_page_recycle(glas_page* page) {
-    if(page->cycle_acquired > page->cycle_released) { return false; }
+    if(glas_page_is_owned(page)) { return false; }
     if(page->defer_reuse > 0) {
         --(page->defer_reuse);
         return false;
     }
     return true;
 }
+LOCAL inline void glas_page_copy_marked_to_marking(glas_page* page) {
+    // for minor GC, cells marked in prior cycle are treated as old
+    memcpy(page->marking, page->marked, GLAS_PAGE_CELL_COUNT/8);
+}
+LOCAL inline void glas_page_clear_cards(glas_page* page) {
+    memset(page->cards, 0, sizeof(page->cards));
+}
+LOCAL inline bool glas_gc_heuristic_decide_next_full() {
+    // a simple policy, but old garbage is only collected by full GC
+    return glas_rt.gc.full_requested || 
+           (glas_rt.gc.minor_count >= GLAS_GC_MINOR_MAX);
+}
 LOCAL void glas_gc_pages_include(glas_page* page) {
     // rebuild a 'gc_next' list of pages
     while(NULL != page) {
@@ -2236,42 +3534,440 @@ LOCAL void glas_gc_pages_include(glas_page* page) {
         page = page->next;
     }
 }
-LOCAL void* glas_gc_main_thread(void* arg) {
-    (void)arg; // unused
-    glas_gc_workers_init();
-    glas_gc_dq_init(&glas_rt.gc.dq);
-    glas_gc_mb* mb = glas_gc_mb_new();
-    do {
-        // check some assumptions
-        assert(!glas_os_thread_is_busy() &&
-            !atomic_load_explicit(&glas_rt.gc.stopping, memory_order_relaxed) &&
-            !glas_rt.gc.marking && glas_gc_mb_is_empty(mb) &&
-            (NULL == atomic_load_explicit(&glas_rt.gc.mb, memory_order_relaxed)) &&
-            (GLAS_VOID == atomic_load_explicit(&glas_rt.gc.wb, memory_order_relaxed)) &&
-            (NULL == glas_rt.gc.roots_snapshot) &&
-            glas_gc_workers_are_done());
-
-        // skip sleep if GC request is pending, otherwise wait for timer or wakeup
-        if(!atomic_exchange_explicit(&glas_rt.gc.trigger, false, memory_order_relaxed)) {
-            static struct timespec const gc_poll_period = { .tv_nsec = (GLAS_GC_POLL_USEC * 1000) };
-            sem_timedwait(&glas_rt.gc.wakeup, &gc_poll_period);
-        }
-        do {} while(0 == sem_trywait(&glas_rt.gc.wakeup)); // drain extra wakeups
-
-        if(!glas_gc_heuristic_level()) { 
-            continue; 
-        }
 
-        // clear old marks? We'll handle that after swap, before returning pages to avail pool
-        glas_gc_stop_the_world();
-        // flip scan bits and activate write barrier
-        glas_rt.gc.gcbits = glas_gc_b0scan() ? 0b111 : 0; 
+/**
+ * Compaction. Pages that remain sparse over several sweeps are evacuated
+ * at the end of a full cycle while the world is stopped. Live cells are
+ * copied to fresh pages, leaving forwarding pointers, then we fix every
+ * reference in live cells and roots. This pause is proportional to the
+ * live heap, so we don't compact every cycle.
+ * 
+ * We don't move cells with identity, i.e. foreign pointers (registered
+ * for finalization), mutable references, tombstones, and thunks, nor
+ * medium blocks. Pages holding such cells aren't evacuated.
+ */
+LOCAL inline bool glas_cell_is_pinned(glas_cell* cell) {
+    switch(cell->hdr.type_id) {
+        case GLAS_TYPE_FOREIGN_PTR:
+        case GLAS_TYPE_REFERENCE:
+        case GLAS_TYPE_TOMBSTONE:
+        case GLAS_TYPE_THUNK:
+            return true;
+        default:
+            return glas_cell_is_buffer_owner(cell);
+    }
+}
+LOCAL size_t glas_page_live_count(glas_page* page) {
+    size_t count = 0;
+    for(size_t ix = 0; ix < (GLAS_PAGE_CELL_COUNT/64); ++ix) {
+        count += popcount64(atomic_load_explicit(page->marked + ix, memory_order_relaxed));
+    }
+    return count;
+}
+LOCAL bool glas_page_has_pinned_cells(glas_page* page) {
+    for(size_t w = 0; w < (GLAS_PAGE_CELL_COUNT/64); ++w) {
+        uint64_t live = atomic_load_explicit(page->marked + w, memory_order_relaxed);
+        while(0 != live) {
+            glas_cell* const cell = ((glas_cell*)page) + (w * 64) + ctz64(live);
+            live &= (live - 1);
+            if(glas_cell_is_pinned(cell)) { return true; }
+        }
+    }
+    return false;
+}
+LOCAL bool glas_gc_heuristic_decide_page_evac(glas_page* page, bool forced) {
+    if((0 != page->size_class) || glas_page_is_owned(page)) { return false; }
+    // chronically fragmented: page is not emptied, e.g. 12%+ utilization
+    // for several sweeps, but currently less than half full
+    static size_t const chronic_sweeps = 3;
+    if(!forced && (glas_page_utilization_run_of(page, UINT8_C(32)) < chronic_sweeps)) { 
+        return false; 
+    }
+    size_t const live = glas_page_live_count(page);
+    size_t const capacity = GLAS_PAGE_CELL_COUNT - glas_size_class_first_cell(0);
+    if((0 == live) || ((2 * live) >= capacity)) { return false; }
+    return !glas_page_has_pinned_cells(page);
+}
+LOCAL inline void glas_gc_evac_fix(glas_cell** slot) {
+    glas_cell* const cell = (*slot);
+    if(GLAS_DATA_IS_PTR(cell) && glas_page_from_internal_addr(cell)->evacuating) {
+        (*slot) = cell->small_arr[0];
+    }
+}
+LOCAL inline void glas_gc_evac_fix_atomic(_Atomic(glas_cell*)* slot) {
+    glas_cell* cell = atomic_load_explicit(slot, memory_order_relaxed);
+    glas_gc_evac_fix(&cell);
+    atomic_store_explicit(slot, cell, memory_order_relaxed);
+}
+LOCAL void glas_gc_evac_fix_cell(glas_cell* cell) {
+    switch(cell->hdr.type_id) {
+        case GLAS_TYPE_BRANCH:
+            glas_gc_evac_fix(&(cell->branch.L));
+            glas_gc_evac_fix(&(cell->branch.R));
+            return;
+        case GLAS_TYPE_STEM:
+            glas_gc_evac_fix(&(cell->stem.fby));
+            return;
+        case GLAS_TYPE_STEM_OF_BIN:
+            glas_gc_evac_fix(&(cell->stem_of_bin.binary));
+            glas_gc_evac_fix(&(cell->stem_of_bin.fby));
+            return;
+        case GLAS_TYPE_SMALL_ARR:
+            glas_gc_evac_fix(cell->small_arr + 0);
+            glas_gc_evac_fix(cell->small_arr + 1);
+            glas_gc_evac_fix(cell->small_arr + 2);
+            return;
+        case GLAS_TYPE_BIG_ARR:
+            // slices may share data; fixing twice is harmless
+            glas_gc_evac_fix(&(cell->big_arr.fptr));
+            for(size_t ix = 0; ix < cell->big_arr.len; ++ix) {
+                glas_gc_evac_fix(cell->big_arr.data + ix);
+            }
+            return;
+        case GLAS_TYPE_BIG_BIN:
+            glas_gc_evac_fix(&(cell->big_bin.fptr));
+            return;
+        case GLAS_TYPE_INT_ARR:
+            glas_gc_evac_fix(&(cell->int_arr.fptr));
+            return;
+        case GLAS_TYPE_EXTREF:
+            glas_gc_evac_fix(&(cell->extref.ref));
+            glas_gc_evac_fix(&(cell->extref.ts));
+            return;
+        case GLAS_TYPE_THUNK:
+            glas_gc_evac_fix_atomic(&(cell->thunk.claim));
+            glas_gc_evac_fix_atomic(&(cell->thunk.closure));
+            glas_gc_evac_fix_atomic(&(cell->thunk.result));
+            return;
+        case GLAS_TYPE_SEAL:
+            glas_gc_evac_fix(&(cell->seal.key));
+            glas_gc_evac_fix(&(cell->seal.meta));
+            glas_gc_evac_fix(&(cell->seal.data));
+            return;
+        case GLAS_TYPE_REFERENCE:
+            glas_gc_evac_fix_atomic(&(cell->ref.value));
+            glas_gc_evac_fix_atomic(&(cell->ref.assoc_lhs));
+            glas_gc_evac_fix_atomic(&(cell->ref.ts));
+            return;
+        case GLAS_TYPE_TOMBSTONE:
+            glas_gc_evac_fix_atomic(&(cell->ts.wk));
+            return;
+        case GLAS_TYPE_TAKE_CONCAT:
+            glas_gc_evac_fix(&(cell->take_concat.left));
+            glas_gc_evac_fix(&(cell->take_concat.right));
+            return;
+        case GLAS_TYPE_SMALL_BIN:
+        case GLAS_TYPE_FOREIGN_PTR:
+            return;
+    }
+    debug("unhandled cell type: %d", (int) cell->hdr.type_id);
+    abort();
+}
+LOCAL void glas_gc_evac_fix_page(glas_page* page) {
+    size_t const stride = ((size_t)1) << page->size_class;
+    for(size_t w = 0; w < (GLAS_PAGE_CELL_COUNT/64); ++w) {
+        uint64_t live = atomic_load_explicit(page->marked + w, memory_order_relaxed);
+        while(0 != live) {
+            size_t const ix = (w * 64) + ctz64(live);
+            live &= (live - 1);
+            assert(likely(0 == (ix % stride)));
+            (void)stride;
+            glas_gc_evac_fix_cell(((glas_cell*)page) + ix);
+        }
+    }
+}
+LOCAL void glas_gc_evac_fix_roots(glas_roots* r) {
+    glas_cell** const base = (glas_cell**) r->self;
+    for(size_t ix = 0; ix < r->root_count; ++ix) {
+        glas_gc_evac_fix(base + r->roots[ix]);
+    }
+}
+typedef struct glas_gc_evac { 
+    glas_page* page;    // current target page
+    size_t ix;          // search for free cells from here
+    glas_page* pages;   // full target pages, via 'next'
+    size_t node;        // NUMA node for new target pages
+} glas_gc_evac;
+LOCAL glas_cell* glas_gc_evac_alloc(glas_gc_evac* e) {
+    do {
+        if(NULL == e->page) {
+            e->page = glas_rt_page_alloc_empty(0, e->node);
+            e->page->next = NULL;
+            e->ix = glas_size_class_first_cell(0);
+            glas_gc_pages_include(e->page); // fix and clear with other pages
+        }
+        while(e->ix < GLAS_PAGE_CELL_COUNT) {
+            size_t const ix = (e->ix)++;
+            _Atomic(uint64_t)* const pmarked = e->page->marked + (ix / 64);
+            uint64_t const bit = UINT64_C(1) << (ix % 64);
+            if(0 == (bit & atomic_load_explicit(pmarked, memory_order_relaxed))) {
+                atomic_fetch_or_explicit(pmarked, bit, memory_order_relaxed);
+                return ((glas_cell*)(e->page)) + ix;
+            }
+        }
+        e->page->next = e->pages;
+        e->pages = e->page;
+        e->page = NULL;
+    } while(1);
+}
+LOCAL void glas_gc_evac_page(glas_gc_evac* e, glas_page* page) {
+    size_t count = 0;
+    e->node = page->node;
+    for(size_t w = 0; w < (GLAS_PAGE_CELL_COUNT/64); ++w) {
+        uint64_t live = atomic_load_explicit(page->marked + w, memory_order_relaxed);
+        while(0 != live) {
+            glas_cell* const src = ((glas_cell*)page) + (w * 64) + ctz64(live);
+            live &= (live - 1);
+            glas_cell* const dst = glas_gc_evac_alloc(e);
+            (*dst) = (*src); // includes gcbits
+            src->small_arr[0] = dst; // forwarding
+            ++count;
+        }
+    }
+    atomic_fetch_add_explicit(&glas_rt.stat.gc_evac_cells, count, memory_order_relaxed);
+}
+LOCAL size_t glas_gc_evac_select(glas_page** list, glas_page** evac_pages, size_t max, bool forced) {
+    // move evacuation candidates from list to evac_pages
+    size_t count = 0;
+    glas_page** cursor = list;
+    while((NULL != (*cursor)) && (count < max)) {
+        glas_page* const page = (*cursor);
+        if(glas_gc_heuristic_decide_page_evac(page, forced)) {
+            (*cursor) = page->next;
+            page->next = (*evac_pages);
+            (*evac_pages) = page;
+            page->evacuating = true;
+            ++count;
+        } else {
+            cursor = &(page->next);
+        }
+    }
+    return count;
+}
+/**
+ * Evacuate sparse pages from the recycle and avail lists, returning the
+ * list of pages to free after marks are cleared. Only call while world
+ * is stopped, after full GC marking is complete and marks swapped.
+ */
+LOCAL glas_page* glas_gc_compact(glas_page** recycle_pages, bool forced) {
+    assert(likely(glas_gc_has_stopped_the_world() && !glas_rt.gc.marking));
+    glas_page* evac_pages = NULL;
+    size_t evac_count = glas_gc_evac_select(recycle_pages, &evac_pages, GLAS_GC_EVAC_PAGES_MAX, forced);
+    // sparse pages recycled in prior cycles may idle in the avail lists
+    for(size_t node = 0; node < glas_rt.alloc.node_count; ++node) {
+        glas_alloc_l* const avail = glas_rt_avail(node, 0);
+        glas_page* avail_pages = glas_allocl_take_all(avail);
+        evac_count += glas_gc_evac_select(&avail_pages, &evac_pages, (GLAS_GC_EVAC_PAGES_MAX - evac_count), forced);
+        while(NULL != avail_pages) {
+            glas_page* const page = avail_pages;
+            avail_pages = page->next;
+            page->next = NULL;
+            glas_allocl_push(avail, page);
+        }
+    }
+    if(!forced && (evac_count < GLAS_GC_EVAC_PAGES_MIN)) {
+        // not worth the pause; let the pages be recycled as usual
+        while(NULL != evac_pages) {
+            glas_page* const page = evac_pages;
+            evac_pages = page->next;
+            page->evacuating = false;
+            page->next = (*recycle_pages);
+            (*recycle_pages) = page;
+        }
+        return NULL;
+    }
+    // copy live cells, leaving forwarding pointers
+    glas_gc_evac e = { .page = NULL, .ix = 0, .pages = NULL, .node = 0 };
+    for(glas_page* page = evac_pages; (NULL != page); page = page->next) {
+        glas_gc_evac_page(&e, page);
+    }
+    // fix references from all live cells and roots
+    for(glas_page* page = glas_rt.gc.pages; (NULL != page); page = page->gc_next) {
+        if(!page->evacuating) {
+            glas_gc_evac_fix_page(page);
+        }
+    }
+    for(glas_roots* r = atomic_load_explicit(&glas_rt.root.list, memory_order_relaxed); 
+        (NULL != r); r = r->next) 
+    {
+        glas_gc_evac_fix_roots(r);
+    }
+    glas_gc_evac_fix_atomic(&glas_rt.root.conf);
+    glas_gc_evac_fix_atomic(&glas_rt.root.globals);
+    // new pages are swept like any other after the next cycle
+    if(NULL != e.page) {
+        e.page->next = e.pages;
+        e.pages = e.page;
+    }
+    while(NULL != e.pages) {
+        glas_page* const page = e.pages;
+        e.pages = page->next;
+        page->next = NULL;
+        glas_allocl_push(&glas_rt.alloc.await, page);
+    }
+    atomic_fetch_add_explicit(&glas_rt.stat.gc_evac_pages, evac_count, memory_order_relaxed);
+    return evac_pages;
+}
+LOCAL inline bool glas_gc_heuristic_decide_compact() {
+    return glas_rt.gc.compact_requested || 
+           (glas_rt.gc.full_count >= GLAS_GC_COMPACT_PERIOD);
+}
+
+/**
+ * Returning memory to the OS. Empty pages are mostly freed as they're
+ * recycled, keeping a small reserve. Heaps are destroyed only while the
+ * world is stopped because mutators search the heaps list without locks.
+ */
+LOCAL void glas_gc_extract_empty_avail(glas_page** recycle_pages) {
+    // pages idle in avail lists may be emptied by a later GC cycle
+    assert(likely(glas_gc_has_stopped_the_world()));
+    for(size_t ix = 0; ix < (glas_rt.alloc.node_count * GLAS_SIZE_CLASS_COUNT); ++ix) {
+        glas_alloc_l* const l = glas_rt_avail((ix / GLAS_SIZE_CLASS_COUNT), (ix % GLAS_SIZE_CLASS_COUNT));
+        glas_page* pages = glas_allocl_take_all(l);
+        while(NULL != pages) {
+            glas_page* const page = pages;
+            pages = page->next;
+            if(glas_page_is_empty(page)) {
+                page->next = (*recycle_pages);
+                (*recycle_pages) = page;
+            } else {
+                page->next = NULL;
+                glas_allocl_push(l, page);
+            }
+        }
+    }
+}
+LOCAL void glas_gc_release_idle_pages() {
+    assert(likely(glas_gc_has_stopped_the_world()));
+    uint64_t const cycle = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
+    glas_page* pages = glas_allocl_take_all(&glas_rt.alloc.empty);
+    while(NULL != pages) {
+        glas_page* const page = pages;
+        pages = page->next;
+        page->next = NULL;
+        if((cycle - page->cycle_emptied) > GLAS_HEAP_PAGE_IDLE_CYCLES) {
+            glas_heap_free_page(page->heap, page);
+        } else {
+            glas_allocl_push(&glas_rt.alloc.empty, page);
+        }
+    }
+}
+LOCAL void glas_gc_release_empty_heaps() {
+    assert(likely(glas_gc_has_stopped_the_world()));
+    glas_rt_alloc_lock();
+    glas_heap* const newest = atomic_load_explicit(&glas_rt.alloc.heaps, memory_order_acquire);
+    if(NULL != newest) {
+        // keep the newest heap to avoid thrashing mmap
+        glas_heap** cursor = &(newest->next);
+        while(NULL != (*cursor)) {
+            glas_heap* const heap = (*cursor);
+            if(glas_heap_is_empty(heap)) {
+                (*cursor) = heap->next;
+                glas_heap_destroy(heap);
+            } else {
+                cursor = &(heap->next);
+            }
+        }
+    }
+    glas_rt_alloc_unlock();
+}
+LOCAL void glas_gc_recycle_empty_page(glas_page* page, glas_page** free_pages) {
+    // keep a few empty pages for reuse, the others are returned to the 
+    // OS after we're done with marking bitmaps
+    size_t const reserve = atomic_load_explicit(&glas_rt.alloc.empty.page_count, memory_order_relaxed);
+    if(reserve >= GLAS_HEAP_EMPTY_RESERVE) {
+        page->next = (*free_pages);
+        (*free_pages) = page;
+    } else {
+        page->cycle_emptied = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_relaxed);
+        glas_allocl_push(&glas_rt.alloc.empty, page);
+    }
+}
+LOCAL void glas_gc_signal_cycle_done() {
+    // wake threads awaiting memory
+    glas_rt_alloc_lock();
+    pthread_cond_broadcast(&glas_rt.alloc.cycle_done);
+    glas_rt_alloc_unlock();
+}
+LOCAL void* glas_gc_main_thread(void* arg) {
+    (void)arg; // unused
+    glas_gc_workers_init();
+    glas_gc_dq_init(&glas_rt.gc.dq);
+    glas_gc_pacer_init();
+    glas_gc_mb* mb = glas_gc_mb_new();
+    do {
+        // check some assumptions
+        assert(!glas_os_thread_is_busy() &&
+            !atomic_load_explicit(&glas_rt.gc.stopping, memory_order_relaxed) &&
+            !glas_rt.gc.marking && glas_gc_mb_is_empty(mb) &&
+            glas_gc_deques_are_empty() &&
+            (NULL == atomic_load_explicit(&glas_rt.gc.satb, memory_order_relaxed)) &&
+            (NULL == glas_rt.gc.roots_snapshot) &&
+            glas_gc_workers_are_done());
+
+        // skip sleep if GC request is pending, otherwise wait for wakeup. 
+        // Allocation wakes us via pacer; the timeout covers idle cleanup.
+        if(!atomic_exchange_explicit(&glas_rt.gc.trigger, false, memory_order_relaxed)) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += (GLAS_GC_IDLE_USEC * 1000);
+            if(deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec += 1;
+                deadline.tv_nsec -= 1000000000;
+            }
+            sem_timedwait(&glas_rt.gc.wakeup, &deadline);
+        }
+        do {} while(0 == sem_trywait(&glas_rt.gc.wakeup)); // drain extra wakeups
+
+        if(!glas_gc_heuristic_level()) { 
+            continue; 
+        }
+
+        // clear old marks? We'll handle that after swap, before returning pages to avail pool
+        glas_gc_stop_the_world();
+        bool const full = glas_rt.gc.next_full;
+        // flip scan bits (cells only for full GC) and activate write barrier
+        glas_rt.gc.roots_b0scan = !glas_rt.gc.roots_b0scan;
+        if(full) {
+            glas_rt.gc.scanbits ^= GLAS_GCBITS_SCAN;
+            glas_rt.gc.full_requested = false;
+            glas_rt.gc.minor_count = 0;
+            (glas_rt.gc.full_count)++;
+            atomic_fetch_add_explicit(&glas_rt.stat.gc_full, 1, memory_order_relaxed);
+        } else {
+            (glas_rt.gc.minor_count)++;
+            atomic_fetch_add_explicit(&glas_rt.stat.gc_minor, 1, memory_order_relaxed);
+        }
+        glas_rt.gc.gcbits = glas_rt.gc.scanbits;
         glas_rt.gc.marking = true;
 
         // gather some stats to help with heuristic decisions
-        glas_rt.gc.prior_page_ct = atomic_load_explicit(&glas_rt.stat.page_release, memory_order_relaxed);
+        glas_rt.gc.pacer.cycle_start = atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed);
         glas_rt.gc.prior_root_ct = atomic_load_explicit(&glas_rt.stat.roots_init, memory_order_relaxed);
 
+        // we'll only recycle pages in the 'await' list BEFORE concurrent marking;
+        // pages added during concurrent mark are filled with new allocations
+
+        // just grab them all, we'll process this list after marking completes
+        glas_gc_drain_page_caches();
+        glas_page* recycle_pages = glas_allocl_take_all(&glas_rt.alloc.await);
+
+        // Pages in the 'empty' list have no marks, thus no old cells.
+        glas_rt.gc.pages = NULL;
+        for(size_t ix = 0; ix < (glas_rt.alloc.node_count * GLAS_SIZE_CLASS_COUNT); ++ix) {
+            glas_alloc_l* const l = glas_rt_avail((ix / GLAS_SIZE_CLASS_COUNT), (ix % GLAS_SIZE_CLASS_COUNT));
+            glas_gc_pages_include(glas_allocl_peek(l));
+        }
+        glas_gc_pages_include(recycle_pages);
+        for(glas_page* page = glas_rt.gc.pages; (NULL != page); page = page->gc_next) {
+            if(full) {
+                // full GC traces everything, so we don't need cards
+                glas_page_clear_cards(page);
+            } else {
+                glas_page_copy_marked_to_marking(page);
+            }
+        }
+
         // touch mutator threads, grab finalizers
         for(glas_os_thread* t = atomic_load_explicit(&glas_rt.tls.list, memory_order_acquire); 
             (NULL != t); t = t->next) 
@@ -2282,6 +3978,14 @@ LOCAL void* glas_gc_main_thread(void* arg) {
                 atomic_pushlist(&glas_rt.gc.fl, &(t->fl->next), t->fl);
                 t->fl = NULL;
             }
+            // words reserved before marking are allocated during marking
+            for(size_t sc = 0; sc < GLAS_SIZE_CLASS_COUNT; ++sc) {
+                struct glas_os_thread_alloc* const a = t->alloc + sc;
+                if((NULL != a->page) && (0 != a->free_bits)) {
+                    atomic_fetch_or_explicit((a->page->marking + a->mark_word),
+                        a->free_bits, memory_order_relaxed);
+                }
+            }
         }
         
         // garbage outside the heaps
@@ -2292,21 +3996,29 @@ LOCAL void* glas_gc_main_thread(void* arg) {
         glas_rt.gc.roots_snapshot = atomic_load_explicit(&glas_rt.root.list, memory_order_relaxed);
         glas_cell* const conf = atomic_load_explicit(&glas_rt.root.conf, memory_order_relaxed);
         glas_cell* const globals = atomic_load_explicit(&glas_rt.root.globals, memory_order_relaxed);
-        glas_gc_fl* const fl = atomic_load_explicit(&glas_rt.gc.fl, memory_order_acquire);
-
-        // we'll only recycle pages in the 'await' list BEFORE concurrent marking;
-        // pages added during concurrent mark are filled with new allocations
+        glas_gc_fl* const fl = atomic_exchange_explicit(&glas_rt.gc.fl, NULL, memory_order_acquire);
+        for(glas_roots* r = glas_rt.gc.roots_snapshot; (NULL != r); r = r->next) {
+            glas_gc_shade_eager_roots(&mb, r);
+        }
 
-        // just grab them all, we'll process this list after marking completes
-        glas_page* recycle_pages = atomic_exchange_explicit(&glas_rt.alloc.await.page_list, NULL, memory_order_relaxed);
-        atomic_store_explicit(&glas_rt.alloc.await.page_count, 0, memory_order_relaxed);
+        // old cells in dirty cards are extra roots for minor GC
+        if(!full) {
+            for(glas_page* page = glas_rt.gc.pages; (NULL != page); page = page->gc_next) {
+                glas_gc_trace_dirty_cards(&mb, page);
+            }
+        }
 
         // update GC cycle
         atomic_fetch_add_explicit(&glas_rt.gc.cycle, 1, memory_order_release);
+        struct timespec mark_start;
+        clock_gettime(CLOCK_MONOTONIC, &mark_start);
         glas_gc_resume_the_world();
 
-        // initiate parallel marking
-        glas_gc_workers_signal(); 
+        // initiate parallel marking, scaled to expected work
+        glas_gc_workers_signal(full ? glas_rt.gc.pacer.live_pages : glas_rt.gc.pacer.cycle_alloc); 
+
+        // new finalizers are allocated before marking, so can't be missed
+        glas_gc_fin_fold(fl);
 
         // handle main thread's share of marking
         glas_gc_mark_cell(&mb, conf);
@@ -2330,9 +4042,12 @@ LOCAL void* glas_gc_main_thread(void* arg) {
         // trace near stop to better win races with write barriers
         glas_gc_trace_marked_cells(&mb);
         while(!glas_gc_workers_are_done()) {
+            glas_gc_workers_grow();
             sched_yield();
             glas_gc_trace_marked_cells(&mb);
         }
+        // parked workers stay parked until next cycle
+        atomic_store_explicit(&glas_rt.gc.pool.open, false, memory_order_release);
 
         glas_gc_stop_the_world();
         if(glas_gc_trace_find_work(&mb)) {
@@ -2347,38 +4062,110 @@ LOCAL void* glas_gc_main_thread(void* arg) {
                 glas_gc_trace_marked_cells(&mb);
             }
         }
+        struct timespec mark_end;
+        clock_gettime(CLOCK_MONOTONIC, &mark_end);
+        atomic_fetch_add_explicit(&glas_rt.stat.gc_mark_nsec, (uint64_t)
+            (((mark_end.tv_sec - mark_start.tv_sec) * INT64_C(1000000000)) + 
+             (mark_end.tv_nsec - mark_start.tv_nsec)), memory_order_relaxed);
         // build complete list of pages
+        glas_gc_drain_page_caches();
         glas_rt.gc.pages = NULL;
-        glas_gc_pages_include(atomic_load_explicit(&glas_rt.alloc.avail.page_list, memory_order_acquire));
-        glas_gc_pages_include(atomic_load_explicit(&glas_rt.alloc.await.page_list, memory_order_acquire));
+        for(size_t ix = 0; ix < (glas_rt.alloc.node_count * GLAS_SIZE_CLASS_COUNT); ++ix) {
+            glas_alloc_l* const l = glas_rt_avail((ix / GLAS_SIZE_CLASS_COUNT), (ix % GLAS_SIZE_CLASS_COUNT));
+            glas_gc_pages_include(glas_allocl_peek(l));
+        }
+        glas_gc_pages_include(glas_allocl_peek(&glas_rt.alloc.await));
         glas_gc_pages_include(recycle_pages);
-        // swap the marked and marking buffers
+        // swap the marked and marking buffers, and list finalizer pages
+        glas_page* fin_pages = NULL;
+        size_t fin_page_count = 0;
         for(glas_page* page = glas_rt.gc.pages; (NULL != page); page = page->gc_next) {
             glas_page_swap_marked_marking(page);
+            if(page->fin) {
+                atomic_store_explicit(&(page->fin_pending), true, memory_order_relaxed);
+                page->fin_next = fin_pages;
+                fin_pages = page;
+                ++fin_page_count;
+            }
+        }
+        atomic_store_explicit(&glas_rt.gc.fin_pages, fin_pages, memory_order_release);
+        // words reserved during marking are partially allocated after marking;
+        // unmark the remainder so it isn't mistaken for old cells by minor GC.
+        // Also drop reserved cells in finalizer cards until finalizers run.
+        for(glas_os_thread* t = atomic_load_explicit(&glas_rt.tls.list, memory_order_acquire); 
+            (NULL != t); t = t->next) 
+        {
+            for(size_t sc = 0; sc < GLAS_SIZE_CLASS_COUNT; ++sc) {
+                struct glas_os_thread_alloc* const a = t->alloc + sc;
+                if((NULL != a->page) && (0 != a->free_bits)) {
+                    atomic_fetch_and_explicit((a->page->marked + a->mark_word),
+                        ~(a->free_bits), memory_order_relaxed);
+                    if(a->page->fin) {
+                        uint64_t const drop = a->free_bits & glas_page_fin_cell_mask(a->page, a->mark_word);
+                        a->free_bits &= ~drop;
+                        a->free_count -= popcount64(drop);
+                    }
+                }
+            }
         }
         // marking completed!
         glas_rt.gc.roots_snapshot = NULL;
         glas_rt.gc.marking = false;
+        // return memory to the OS after load spikes
+        glas_gc_extract_empty_avail(&recycle_pages);
+        glas_gc_release_idle_pages();
+        glas_gc_release_empty_heaps();
+        // occasionally evacuate sparse pages; requires complete marks
+        glas_page* free_pages = NULL;
+        if(full && glas_gc_heuristic_decide_compact()) {
+            free_pages = glas_gc_compact(&recycle_pages, glas_rt.gc.compact_requested);
+            glas_rt.gc.compact_requested = false;
+            glas_rt.gc.full_count = 0;
+        }
+        // decide kind of next cycle; for minor GC, new cells are unscanned
+        glas_rt.gc.next_full = glas_gc_heuristic_decide_next_full();
+        glas_rt.gc.gcbits = glas_rt.gc.next_full ? glas_rt.gc.scanbits :
+            (GLAS_GCBITS_SCAN ^ glas_rt.gc.scanbits);
+        if(glas_rt.gc.full_requested) {
+            atomic_store_explicit(&glas_rt.gc.trigger, true, memory_order_relaxed);
+        }
         glas_gc_resume_the_world();
         
         // must run finalizers before recycling pages
-        glas_gc_thread_run_finalizers(fl);
+        glas_gc_run_finalizers(fin_page_count);
 
         // recycle pages
         while(NULL != recycle_pages) {
             glas_page* const page = recycle_pages;
             recycle_pages = page->next;
             page->next = NULL;
+            if(!glas_page_is_owned(page) && glas_page_is_empty(page)) {
+                // empty pages may be reused for any size class
+                glas_gc_recycle_empty_page(page, &free_pages);
+                continue;
+            }
             bool const recycle = glas_gc_heuristic_decide_page_recycle(page);
-            glas_alloc_l* const dst = recycle ? &glas_rt.alloc.avail : &glas_rt.alloc.await;
+            glas_alloc_l* const dst = recycle ? glas_rt_avail(page->node, page->size_class) : &glas_rt.alloc.await;
             glas_allocl_push(dst, page);
         }
 
         // prepare for next GC cycle by clearing the marking bitmaps. The 'marked'
-        // bitmap remains for lazy allocation on sweep
+        // bitmap remains for lazy allocation on sweep. Count live cells for pacer.
+        uint64_t live_cells = 0;
         for(glas_page* page = glas_rt.gc.pages; (NULL != page); page = page->gc_next) {
             glas_page_clear_marking(page);
+            if(!page->evacuating) {
+                live_cells += glas_page_live_count(page) << page->size_class;
+            }
         }
+        // evacuated and surplus empty pages are returned to the OS
+        while(NULL != free_pages) {
+            glas_page* const page = free_pages;
+            free_pages = page->next;
+            glas_heap_free_page(page->heap, page);
+        }
+        glas_gc_pacer_update(live_cells);
+        glas_gc_signal_cycle_done();
     } while(1);
     __builtin_unreachable();
 }
@@ -2483,34 +4270,90 @@ LOCAL inline void glas_thread_state_incref(glas_thread_state* ts) {
 LOCAL inline void glas_thread_state_decref(glas_thread_state* ts) {
     glas_roots_decref(&(ts->gcbase));
 }
-LOCAL void glas_thread_state_init(glas_thread_state* ts) {
-    glas_roots_init(&(ts->gcbase), ts, glas_thread_state_free, glas_thread_state_offsets);
+LOCAL void glas_thread_state_reset(glas_thread_state* ts) {
+    // assumes root slots are void, i.e. new or cleared
     ts->stack.count = 0;
     ts->stack.overflow = GLAS_VAL_UNIT;
+    ts->stack.spill_trend = 0;
     ts->stash.count = 0;
     ts->stash.overflow = GLAS_VAL_UNIT;
+    ts->stash.spill_trend = 0;
     ts->debug_name = GLAS_VAL_UNIT;
     ts->ns = GLAS_VAL_UNIT;
     ts->checkpoint = NULL;
     ts->err = GLAS_NO_ERRORS;
 }
+LOCAL void glas_thread_state_init(glas_thread_state* ts) {
+    glas_roots_init(&(ts->gcbase), ts, glas_thread_state_free, glas_thread_state_offsets,
+        GLAS_GC_EAGER_STACKS ? (2 * (1 + GLAS_STACK_MAX)) : 0);
+    glas_thread_state_reset(ts);
+}
 LOCAL inline glas_thread_state* glas_thread_state_new() {
+    glas_os_thread* const t = glas_os_thread_get();
+    glas_thread_state* ts = t->ts_pool;
+    if(NULL != ts) {
+        t->ts_pool = ts->checkpoint;
+        t->ts_pool_count--;
+        atomic_fetch_add_explicit(&glas_rt.stat.g_ts_reuse, 1, memory_order_relaxed);
+        glas_thread_state_reset(ts);
+        return ts;
+    }
     atomic_fetch_add_explicit(&glas_rt.stat.g_ts_alloc, 1, memory_order_relaxed);
-    // TBD: Consider a flyweight pattern for recycling of glas_thread_state 
-    glas_thread_state* const ts = malloc(sizeof(glas_thread_state));
+    ts = malloc(sizeof(glas_thread_state));
     glas_thread_state_init(ts);
     return ts;
 }
+LOCAL void glas_thread_state_clear_roots(glas_thread_state* ts) {
+    // write barriers preserve prior values for concurrent marking
+    glas_roots* const r = &(ts->gcbase);
+    glas_os_thread_enter_busy();
+    for(uint16_t const* roots = r->roots; (GLAS_ROOTS_END != (*roots)); ++roots) {
+        glas_cell** const slot = ((glas_cell**)ts) + (*roots);
+        if(GLAS_VOID != (*slot)) {
+            glas_roots_slot_write(r, slot, GLAS_VOID);
+        }
+    }
+    glas_os_thread_exit_busy();
+}
+LOCAL void glas_thread_state_release(glas_thread_state* ts) {
+    // recycle a state we solely own, otherwise decref
+    assert(likely(NULL == ts->checkpoint));
+    glas_os_thread* const t = glas_os_thread_get();
+    if((GLAS_THREAD_STATE_POOL_MAX > t->ts_pool_count) && 
+       (1 == atomic_load_explicit(&(ts->gcbase.refct), memory_order_relaxed))) 
+    {
+        glas_thread_state_clear_roots(ts);
+        ts->checkpoint = t->ts_pool;
+        t->ts_pool = ts;
+        t->ts_pool_count++;
+    } else {
+        glas_thread_state_decref(ts);
+    }
+}
+LOCAL void glas_thread_state_pool_clear(glas_os_thread* t) {
+    // pooled states are finalized by a later GC
+    while(NULL != t->ts_pool) {
+        glas_thread_state* const ts = t->ts_pool;
+        t->ts_pool = ts->checkpoint;
+        ts->checkpoint = NULL;
+        glas_thread_state_decref(ts);
+    }
+    t->ts_pool_count = 0;
+}
 LOCAL inline void glas_stack_copy(glas_stack* dst, glas_stack* src) {
     for(size_t ix = 0; ix < src->count; ++ix) {
         dst->data[ix] = src->data[ix];
     }
     dst->count = src->count;
     dst->overflow = src->overflow;
+    dst->spill_trend = src->spill_trend;
 }
 LOCAL glas_thread_state* glas_thread_state_clone_shallow(glas_thread_state* ts) {
     glas_os_thread_enter_busy();
-    // allocate and build within GC cycle to avoid write barriers. 
+    // clone is fresh or recycled from ts_pool, where release already
+    // cleared its roots via glas_roots_slot_write. Overwriting void slots
+    // within the busy section thus needs no further write barriers; the
+    // copied values remain reachable from ts for the current GC cycle.
     glas_thread_state* const clone = glas_thread_state_new();
     glas_stack_copy(&(clone->stack), &(ts->stack));
     glas_stack_copy(&(clone->stash), &(ts->stash));
@@ -2529,7 +4372,7 @@ LOCAL void glas_thread_state_checkpoints_clear(glas_thread_state* ts) {
         glas_thread_state* tmp = ts->checkpoint;
         ts->checkpoint = tmp->checkpoint;
         tmp->checkpoint = NULL;
-        glas_thread_state_decref(tmp);
+        glas_thread_state_release(tmp);
     }
 }
 API void glas_checkpoints_clear(glas* g) {
@@ -2537,7 +4380,7 @@ API void glas_checkpoints_clear(glas* g) {
 }
 API void glas_step_abort(glas* g) {
     glas_checkpoints_clear(g);
-    glas_thread_state_decref(g->state);
+    glas_thread_state_release(g->state);
     // committed states should have no checkpoints, no errors
     assert(likely((GLAS_NO_ERRORS == g->committed_state->err) &&
                   (NULL == g->committed_state->checkpoint)));
@@ -2557,7 +4400,7 @@ API bool glas_step_commit(glas* g) {
     // TBD: could just use a global mutex for this, perhaps prepare
     //  first and optionally do a once-over without the lock.
     glas_thread_state_checkpoints_clear(g->state);
-    glas_thread_state_decref(g->committed_state);
+    glas_thread_state_release(g->committed_state);
     g->committed_state = glas_thread_state_clone_shallow(g->state);
     return true;
 }
@@ -2572,11 +4415,12 @@ API glas* glas_thread_new() {
     return g;
 }
 API void glas_thread_exit(glas* g) {
+    assert(likely(0 == g->session_depth));
     atomic_fetch_add_explicit(&glas_rt.stat.g_free, 1, memory_order_relaxed);
     glas_step_abort(g);
     glas_checkpoints_clear(g);
-    glas_thread_state_decref(g->state);
-    glas_thread_state_decref(g->committed_state);
+    glas_thread_state_release(g->state);
+    glas_thread_state_release(g->committed_state);
     free(g);
 }
 API void glas_errors_write(glas* g, GLAS_ERROR_FLAGS err) {
@@ -2598,12 +4442,6 @@ API GLAS_ERROR_FLAGS glas_errors_read(glas* g, GLAS_ERROR_FLAGS mask) {
     }
     return (mask & (g->err | g->state->err));
 }
-LOCAL glas_cell* glas_data_list_append(glas_cell* lhs, glas_cell* rhs) {
-    if(GLAS_VAL_UNIT == lhs) { return rhs; }
-    if(GLAS_VAL_UNIT == rhs) { return lhs; }
-    debug("todo: list append");
-    return GLAS_VOID;
-}
 LOCAL void glas_sc_fill_cell_stem_bits(glas_sc* sc) {
     if(GLAS_STEM63_EMPTY == sc->stem) { return; }
     // move stem bits from sc->stem to sc->cell, but without increasing
@@ -2687,12 +4525,134 @@ LOCAL glas_cell* glas_cell_stem_alloc(uint64_t stem, glas_cell* fby) {
     cell->stemHd = (uint32_t)(((bits<<1)|1)<<(31-len));
     return cell;
 }
+/**
+ * Stem of binary. A long bitstring may be a view of a binary, so we don't
+ * allocate a stem cell per 128 bits to convert between them. The view
+ * references a BIG_BIN cell and a bit range within it, so splitting the
+ * view or popping bits from its head is O(1) and shares the buffer.
+ */
+#define GLAS_STEM_OF_BIN_MIN 32     // bytes; shorter binaries use stem cells
+#define GLAS_STEM_OF_BIN_MAX (UINT32_MAX & ~UINT32_C(7)) // bits per view
+LOCAL glas_cell* glas_cell_stem_of_bin_alloc(glas_cell* binary,
+    uint64_t bit_offset, uint64_t bit_len, glas_cell* fby)
+{
+    assert(likely(GLAS_DATA_IS_PTR(binary) && (GLAS_TYPE_BIG_BIN == binary->hdr.type_id)));
+    assert(likely((0 < bit_len) && ((bit_offset + bit_len) <= (8 * binary->big_bin.len))));
+    assert(likely((bit_offset + bit_len) <= UINT32_MAX));
+    glas_cell* const cell = glas_cell_alloc();
+    cell->hdr.type_id = GLAS_TYPE_STEM_OF_BIN;
+    cell->hdr.type_aggr = glas_cell_type_aggr(fby);
+    cell->hdr.type_arg = 0;
+    cell->stemHd = GLAS_STEM31_EMPTY;
+    cell->stem_of_bin.binary = binary;
+    cell->stem_of_bin.fby = fby;
+    cell->stem_of_bin.bit_offset = (uint32_t) bit_offset;
+    cell->stem_of_bin.bit_len = (uint32_t) bit_len;
+    return cell;
+}
+LOCAL inline uint64_t glas_bin_bits_read(glas_cell const* binary, uint64_t pos, size_t len) {
+    // read 1..57 bits from binary starting at bit pos, msb first
+    assert(likely((0 < len) && (len <= 57) && ((pos + len) <= (8 * binary->big_bin.len))));
+    uint8_t const* const data = binary->big_bin.data + (pos / 8);
+    size_t const shift = pos % 8;
+    size_t const nbytes = (shift + len + 7) / 8;
+    uint64_t word = 0;
+    for(size_t ix = 0; ix < nbytes; ++ix) {
+        word |= ((uint64_t)data[ix]) << (56 - (8 * ix));
+    }
+    return (word << shift) >> (64 - len);
+}
+LOCAL inline bool glas_cell_is_stem_of_bin(glas_cell* cell) {
+    // a view without stem bits in stemHd
+    return GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_STEM_OF_BIN == cell->hdr.type_id) &&
+           (GLAS_STEM31_EMPTY == cell->stemHd);
+}
+/**
+ * Stem chain compaction. Pushing bits one at a time builds a chain of
+ * stem cells, about 128 bits per cell, so length and append would walk
+ * O(N) cells. Instead, once GLAS_STEM_CHAIN_MAX stem cells are chained,
+ * we copy them into a binary view. The new view absorbs following views
+ * no larger than itself, like carries in a binary counter, so a pushed
+ * bitstring holds O(log N) views and each bit is copied O(log N) times.
+ */
+#define GLAS_STEM_CHAIN_MAX 8
+LOCAL glas_cell* glas_stem_chain_compact(glas_cell* cell) {
+    glas_cell* tail = cell;
+    uint64_t len = 0;
+    for(size_t ix = 0; ix < GLAS_STEM_CHAIN_MAX; ++ix) {
+        if(!GLAS_DATA_IS_PTR(tail) || (GLAS_TYPE_STEM != tail->hdr.type_id)) {
+            return cell;
+        }
+        len += (31 - ctz32(tail->stemHd)) + (32 * (uint64_t)tail->hdr.type_arg);
+        tail = tail->stem.fby;
+    }
+    if(len < (8 * GLAS_STEM_OF_BIN_MIN)) {
+        return cell; // sparse stem cells, rare
+    }
+    while(glas_cell_is_stem_of_bin(tail) && (tail->stem_of_bin.bit_len <= len) &&
+          ((len + tail->stem_of_bin.bit_len) <= GLAS_STEM_OF_BIN_MAX))
+    {
+        len += tail->stem_of_bin.bit_len;
+        tail = tail->stem_of_bin.fby;
+    }
+    uint8_t* data;
+    glas_cell* const bin = glas_cell_binary_alloc_uninit((len + 7) / 8, &data);
+    size_t pos = 0;
+    uint64_t acc = 0;
+    size_t acc_len = 0;
+    glas_cell* c = cell;
+    while(c != tail) {
+        if(GLAS_TYPE_STEM == c->hdr.type_id) {
+            // stemHd bits, then stem32 from last to first, msb first
+            size_t const hd_len = 31 - ctz32(c->stemHd);
+            uint32_t words[5];
+            size_t lens[5];
+            size_t count = 0;
+            if(0 < hd_len) {
+                words[count] = c->stemHd >> (32 - hd_len);
+                lens[count++] = hd_len;
+            }
+            for(size_t ix = c->hdr.type_arg; ix > 0; --ix) {
+                words[count] = c->stem.stem32[ix - 1];
+                lens[count++] = 32;
+            }
+            for(size_t ix = 0; ix < count; ++ix) {
+                acc = (acc << lens[ix]) | words[ix];
+                acc_len += lens[ix];
+                while(acc_len >= 8) {
+                    acc_len -= 8;
+                    data[pos++] = (uint8_t)(acc >> acc_len);
+                }
+            }
+            c = c->stem.fby;
+        } else {
+            glas_cell* const src = c->stem_of_bin.binary;
+            uint64_t const src_pos = c->stem_of_bin.bit_offset;
+            uint64_t const src_len = c->stem_of_bin.bit_len;
+            for(uint64_t at = 0; at < src_len; at += 32) {
+                size_t const k = ((src_len - at) > 32) ? 32 : (size_t)(src_len - at);
+                acc = (acc << k) | glas_bin_bits_read(src, src_pos + at, k);
+                acc_len += k;
+                while(acc_len >= 8) {
+                    acc_len -= 8;
+                    data[pos++] = (uint8_t)(acc >> acc_len);
+                }
+            }
+            c = c->stem_of_bin.fby;
+        }
+    }
+    if(0 < acc_len) {
+        data[pos++] = (uint8_t)(acc << (8 - acc_len));
+    }
+    assert(likely(((len + 7) / 8) == pos));
+    return glas_cell_stem_of_bin_alloc(bin, 0, len, tail);
+}
 LOCAL void glas_sc_byte_overflow(glas_sc* sc) {
     // in 99% of cases we'll be pushing bits or bytes
     // this will ensure sc->stem has space for at least one byte
     glas_sc_fill_cell_stem_bits(sc);
     if(0 == (0xFF & sc->stem)) { return; }
-    sc->cell = glas_cell_stem_alloc(sc->stem, sc->cell);
+    sc->cell = glas_cell_stem_alloc(sc->stem, glas_stem_chain_compact(sc->cell));
     sc->stem = GLAS_STEM63_EMPTY;
 }
 LOCAL inline void glas_bit_sc_push(bool mkr, glas_sc* sc) {
@@ -2730,67 +4690,175 @@ LOCAL inline glas_cell* glas_sc_to_cell(glas_sc sc) {
     if(GLAS_STEM63_EMPTY == sc.stem) { return sc.cell; }
     return glas_cell_stem_alloc(sc.stem, sc.cell);
 }
+/**
+ * Stack overflow chunks. Each chunk is a small array of three cells: an
+ * array of items (deepest first), a binary of stem words (or unit if all
+ * stems are empty), and the next chunk (or unit). Chunks are immutable,
+ * so cloned stacks may share them.
+ */
+#define GLAS_STACK_CHUNK_ITEMS 0
+#define GLAS_STACK_CHUNK_STEMS 1
+#define GLAS_STACK_CHUNK_NEXT  2
+LOCAL glas_cell* glas_stack_chunk_alloc(glas_sc const* items, size_t len, glas_cell* next) {
+    assert(likely((0 < len) && (len < GLAS_STACK_MAX)));
+    glas_cell* cells[GLAS_STACK_MAX];
+    uint64_t stems[GLAS_STACK_MAX];
+    bool has_stems = false;
+    for(size_t ix = 0; ix < len; ++ix) {
+        cells[ix] = items[ix].cell;
+        stems[ix] = items[ix].stem;
+        has_stems = has_stems || (GLAS_STEM63_EMPTY != items[ix].stem);
+    }
+    // The chunk header, and for a short chunk its items and stems, are
+    // single cells taken in one batch. Longer chunks put items and stems
+    // in medium blocks, which have their own size classes.
+    bool const small = (len < 4);
+    size_t const stems_size = len * sizeof(uint64_t);
+    glas_cell* batch[3];
+    glas_cell_alloc_batch(batch, 1 + (small ? 1 : 0) + ((small && has_stems) ? 1 : 0));
+    glas_cell* parts[3];
+    parts[GLAS_STACK_CHUNK_ITEMS] = small ? glas_cell_small_arr_init(batch[1], cells, len) :
+        glas_cell_array_alloc(cells, len);
+    if(!has_stems) {
+        parts[GLAS_STACK_CHUNK_STEMS] = GLAS_VAL_UNIT;
+    } else if(small) {
+        static_assert(24 >= (3 * sizeof(uint64_t)));
+        glas_cell* const bin = batch[2];
+        bin->hdr.type_id = GLAS_TYPE_SMALL_BIN;
+        bin->hdr.type_arg = stems_size;
+        bin->hdr.type_aggr = 0;
+        bin->stemHd = GLAS_STEM31_EMPTY;
+        memcpy(bin->small_bin, stems, stems_size);
+        parts[GLAS_STACK_CHUNK_STEMS] = bin;
+    } else {
+        parts[GLAS_STACK_CHUNK_STEMS] = glas_cell_binary_alloc((uint8_t const*)stems, stems_size);
+    }
+    parts[GLAS_STACK_CHUNK_NEXT] = next;
+    return glas_cell_small_arr_init(batch[0], parts, 3);
+}
+LOCAL inline glas_cell* glas_stack_chunk_next(glas_cell const* chunk) {
+    assert(likely(GLAS_DATA_IS_PTR(chunk) && (GLAS_TYPE_SMALL_ARR == chunk->hdr.type_id)));
+    return chunk->small_arr[GLAS_STACK_CHUNK_NEXT];
+}
+LOCAL inline size_t glas_stack_chunk_len(glas_cell const* chunk) {
+    glas_cell const* const arr = chunk->small_arr[GLAS_STACK_CHUNK_ITEMS];
+    return (GLAS_TYPE_SMALL_ARR == arr->hdr.type_id) ? 
+        (size_t) arr->hdr.type_arg : arr->big_arr.len;
+}
+LOCAL void glas_stack_chunk_read(glas_cell const* chunk, size_t offset, size_t len, 
+    glas_roots* r, glas_sc* dst)
+{
+    // read items offset..offset+len into dst; roots is NULL for local dst
+    glas_cell const* const arr = chunk->small_arr[GLAS_STACK_CHUNK_ITEMS];
+    glas_cell* const* const cells = (GLAS_TYPE_SMALL_ARR == arr->hdr.type_id) ?
+        arr->small_arr : arr->big_arr.data;
+    glas_cell const* const bin = chunk->small_arr[GLAS_STACK_CHUNK_STEMS];
+    uint8_t const* const stems = (GLAS_VAL_UNIT == bin) ? NULL :
+        (GLAS_TYPE_SMALL_BIN == bin->hdr.type_id) ? bin->small_bin : bin->big_bin.data;
+    for(size_t ix = 0; ix < len; ++ix) {
+        uint64_t stem = GLAS_STEM63_EMPTY;
+        if(NULL != stems) {
+            memcpy(&stem, stems + ((offset + ix) * sizeof(uint64_t)), sizeof(uint64_t));
+        }
+        dst[ix].stem = stem;
+        if(NULL == r) {
+            dst[ix].cell = cells[offset + ix];
+        } else {
+            glas_stack_slot_write(r, &(dst[ix].cell), cells[offset + ix]);
+        }
+    }
+}
+LOCAL size_t glas_stack_spill_target(glas_stack* s, size_t min_count, size_t max_count, bool spill) {
+    // consecutive spills lower the target so we spill bigger chunks less
+    // often, and consecutive refills raise it. Alternating stays central.
+    int8_t const t = s->spill_trend;
+    s->spill_trend = spill ? ((t < 0) ? 1 : ((t < 3) ? (t + 1) : 3))
+                           : ((t > 0) ? -1 : ((t > -3) ? (t - 1) : -3));
+    size_t const span = max_count - min_count;
+    size_t const mid = min_count + (span / 2);
+    int8_t const nt = s->spill_trend;
+    size_t const adj = (span * (size_t)((nt < 0) ? -nt : nt)) / 8;
+    return (nt > 0) ? (mid - adj) : (mid + adj);
+}
 LOCAL bool glas_stack_prep_slowpath(glas_roots* r, glas_stack* s, uint8_t read, uint8_t reserve) {
     size_t const min_count = (size_t) read;
     size_t const max_count = GLAS_STACK_MAX - (size_t) reserve;
     assert(likely(min_count < max_count));
-    size_t const tgt_count = (min_count + max_count) / 2; // heuristic
-    if(tgt_count > s->count) {
-        // TODO: shift this code to use list functions instead of assuming GLAS_TYPE_BRANCH.
-        size_t const tgt_pull = tgt_count - s->count; // from overflow
+    if(min_count > s->count) {
+        // refill whole chunks, splitting the last if it exceeds space
+        size_t const tgt_count = glas_stack_spill_target(s, min_count, max_count, false);
+        assert(likely((tgt_count >= min_count) && (max_count >= tgt_count)));
+        size_t const space = max_count - s->count;
+        size_t const want = tgt_count - s->count;
+        glas_cell* const head = s->overflow;
+        glas_cell* iter = head;
         size_t pull = 0;
-        glas_cell* const head = s->overflow; 
-        glas_cell* list_iter = head;
-        while((GLAS_VAL_UNIT != list_iter) && (pull < tgt_pull)) {
-            assert(likely(GLAS_DATA_IS_PTR(list_iter) && (GLAS_TYPE_BRANCH == list_iter->hdr.type_id)));
-            list_iter = list_iter->branch.R;
-            ++pull;
-        }
-        glas_roots_slot_write(r, &(s->overflow), list_iter);
+        size_t split_take = 0; // items taken from top of chunk at iter
+        while((pull < want) && (GLAS_VAL_UNIT != iter)) {
+            size_t const len = glas_stack_chunk_len(iter);
+            if((pull + len) > space) {
+                split_take = space - pull;
+                break;
+            }
+            pull += len;
+            iter = glas_stack_chunk_next(iter);
+        }
+        glas_cell* tail = iter;
+        if(0 != split_take) {
+            // keep the remainder of the split chunk in overflow
+            size_t const rem = glas_stack_chunk_len(iter) - split_take;
+            glas_sc items[GLAS_STACK_MAX];
+            glas_stack_chunk_read(iter, 0, rem, NULL, items);
+            tail = glas_stack_chunk_alloc(items, rem, glas_stack_chunk_next(iter));
+        }
         // potential underflow
-        size_t const valid_count = s->count + pull;
+        size_t const valid_count = s->count + pull + split_take;
         size_t const underflow_count = likely((valid_count >= min_count)) ? 0 : 
             (min_count - valid_count);
-        size_t const shift = pull + underflow_count;
+        size_t const shift = pull + split_take + underflow_count;
         assert(likely(shift > 0));
-        // shift existing content
-        for(size_t ix = 0; ix < s->count; ++ix) {
+        // shift existing content (top down, since regions may overlap)
+        for(size_t ix = s->count; ix-- > 0; ) {
             glas_sc* const src = s->data + ix;
             glas_sc* const dst = src + shift;
             dst->stem = src->stem;
-            glas_roots_slot_write(r, &(dst->cell), src->cell);
-        }
-        // fill from overflow list
-        list_iter = head;
-        for(size_t ix = 1; pull >= ix; ++ix) {
-            assert(likely(GLAS_DATA_IS_PTR(list_iter) && (GLAS_TYPE_BRANCH == list_iter->hdr.type_id)));
-            glas_sc* const tgt = s->data + shift - ix;
-            tgt->stem = ((uint64_t)list_iter->branch.stemL) << 32;
-            glas_roots_slot_write(r, &(tgt->cell), list_iter->branch.L);
-            list_iter = list_iter->branch.R;
-        }
-        assert(likely(list_iter == s->overflow)); // double check
+            glas_stack_slot_write(r, &(dst->cell), src->cell);
+        }
+        // fill from overflow chunks, topmost chunk first
+        size_t top = shift;
+        for(glas_cell* chunk = head; chunk != iter; chunk = glas_stack_chunk_next(chunk)) {
+            size_t const len = glas_stack_chunk_len(chunk);
+            top -= len;
+            glas_stack_chunk_read(chunk, 0, len, r, s->data + top);
+        }
+        if(0 != split_take) {
+            top -= split_take;
+            glas_stack_chunk_read(iter, glas_stack_chunk_len(iter) - split_take, 
+                split_take, r, s->data + top);
+        }
+        assert(likely(top == underflow_count));
+        glas_stack_slot_write(r, &(s->overflow), tail);
         // fill with GLAS_VOID in case of underflow
         for(size_t ix = 0; ix < underflow_count; ++ix) {
             glas_sc* const tgt = s->data + ix;
             tgt->stem = GLAS_STEM63_EMPTY;
-            glas_roots_slot_write(r, &(tgt->cell), GLAS_VOID);
+            glas_stack_slot_write(r, &(tgt->cell), GLAS_VOID);
         }
+        s->count += shift;
         return (0 == underflow_count);
     } else {
+        // spill one chunk from the bottom of the stack
+        size_t const tgt_count = glas_stack_spill_target(s, min_count, max_count, true);
+        assert(likely((tgt_count >= min_count) && (tgt_count < s->count)));
         size_t const push = s->count - tgt_count; // to overflow
-        glas_cell* head = s->overflow;
-        for(size_t ix = 0; ix < push; ++ix) {
-            glas_sc sc_head = { .stem = GLAS_STEM63_EMPTY, .cell = head };
-            head = glas_cell_pair_alloc_sc(s->data[ix], sc_head);
-        }
-        glas_roots_slot_write(r, &(s->overflow), head);
+        glas_stack_slot_write(r, &(s->overflow), 
+            glas_stack_chunk_alloc(s->data, push, s->overflow));
         for(size_t ix = 0; ix < tgt_count; ++ix) {
             s->data[ix].stem = s->data[ix + push].stem;
-            glas_roots_slot_write(r, &(s->data[ix].cell), s->data[ix + push].cell);
+            glas_stack_slot_write(r, &(s->data[ix].cell), s->data[ix + push].cell);
         }
         for(size_t ix = tgt_count; ix < s->count; ++ix) {
-            glas_roots_slot_write(r, &(s->data[ix].cell), GLAS_VOID);
+            glas_stack_slot_write(r, &(s->data[ix].cell), GLAS_VOID);
         }
         s->count = tgt_count;
         return true;
@@ -2829,7 +4897,7 @@ LOCAL void glas_thread_stack_sc_push(glas* g, glas_sc sc) {
     glas_thread_state* const ts = g->state;
     glas_sc* const dst = ts->stack.data + ts->stack.count;
     dst->stem = sc.stem;
-    glas_roots_slot_write(&(ts->gcbase), &(dst->cell), sc.cell);
+    glas_stack_slot_write(&(ts->gcbase), &(dst->cell), sc.cell);
     ts->stack.count++;
 }
 LOCAL inline void glas_thread_stack_cell_push(glas* g, glas_cell* cell) {
@@ -2842,7 +4910,7 @@ LOCAL glas_sc glas_thread_stack_sc_pop(glas* g) {
     glas_stack* const s = &(ts->stack);
     glas_sc* const psc = &(s->data[--(s->count)]);
     glas_sc const sc = *psc;
-    glas_roots_slot_write(&(g->state->gcbase), &(psc->cell), GLAS_VOID);
+    glas_stack_slot_write(&(g->state->gcbase), &(psc->cell), GLAS_VOID);
     return sc;
 }
 LOCAL glas_cell* glas_thread_stack_pop_cell(glas* g) {
@@ -2890,6 +4958,18 @@ LOCAL uint64_t glas_cell_stem_pop(glas_cell** cell) {
             }
             assert(likely(64 > len));
             return ((bits<<1)|1)<<(63-len);
+        } else if(glas_cell_is_stem_of_bin(*cell)) {
+            // take up to 56 bits from head of view, sharing the binary
+            glas_cell* const view = (*cell);
+            uint64_t const view_len = view->stem_of_bin.bit_len;
+            size_t const len = (view_len > 56) ? 56 : (size_t) view_len;
+            uint64_t const bits = glas_bin_bits_read(view->stem_of_bin.binary, 
+                view->stem_of_bin.bit_offset, len);
+            (*cell) = (len == view_len) ? view->stem_of_bin.fby :
+                glas_cell_stem_of_bin_alloc(view->stem_of_bin.binary,
+                    view->stem_of_bin.bit_offset + len, view_len - len, 
+                    view->stem_of_bin.fby);
+            return ((bits<<1)|1)<<(63-len);
         } else if(GLAS_STEM31_EMPTY != (*cell)->stemHd) {
             (*cell) = glas_cell_clone(*cell);
             uint64_t stem = ((uint64_t)(*cell)->stemHd) << 32;
@@ -2937,6 +5017,9 @@ LOCAL size_t glas_sc_stem_len(glas_sc sc) {
         if(GLAS_TYPE_STEM == cell->hdr.type_id) {
             sum += 32 * (size_t) cell->hdr.type_arg;
             cell = cell->stem.fby;
+        } else if(GLAS_TYPE_STEM_OF_BIN == cell->hdr.type_id) {
+            sum += cell->stem_of_bin.bit_len;
+            cell = cell->stem_of_bin.fby;
         } else {
             cell = GLAS_VOID;
         }
@@ -2963,29 +5046,61 @@ LOCAL inline bool glas_sc_bits_load(glas_sc* sc) {
     return (GLAS_STEM63_EMPTY != sc->stem);
 }
 
-API void glas_binary_push(glas* g, uint8_t const* buf, size_t len) {
-    assert(likely((NULL != buf)));
-    glas_os_thread_enter_busy();
-    glas_thread_stack_cell_push(g, 
-        glas_cell_binary_alloc(buf, len));
-    glas_os_thread_exit_busy();
+/**
+ * API sessions. Outside a session, each API op enters and exits busy,
+ * i.e. a TLS lookup and a seq_cst atomic. Within a session, the OS thread
+ * remains busy, and API ops only poll for GC and heap pressure at entry.
+ * This is a safepoint so API ops must not hold cell pointers across nested
+ * API calls.
+ */
+LOCAL inline void glas_api_enter(glas* g) {
+    if(0 != g->session_depth) {
+        if(unlikely(glas_rt_heap_pressure())) {
+            glas_os_thread_await_memory_slowpath();
+        }
+        glas_os_thread_gc_safepoint();
+    } else {
+        glas_os_thread_enter_busy();
+    }
+}
+LOCAL inline void glas_api_exit(glas* g) {
+    if(0 == g->session_depth) {
+        glas_os_thread_exit_busy();
+    }
+}
+API void glas_session_begin(glas* g) {
+    glas_os_thread_enter_busy();
+    (g->session_depth)++;
+}
+API void glas_session_end(glas* g) {
+    assert(likely(0 < g->session_depth));
+    (g->session_depth)--;
+    glas_os_thread_exit_busy();
+}
+
+API void glas_binary_push(glas* g, uint8_t const* buf, size_t len) {
+    assert(likely((NULL != buf)));
+    glas_api_enter(g);
+    glas_thread_stack_cell_push(g, 
+        glas_cell_binary_alloc(buf, len));
+    glas_api_exit(g);
 }
 API void glas_binary_push_zc(glas* g, uint8_t const* buf, size_t len, glas_refct pin) {
     assert(likely((NULL != buf)));
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_cell_push(g, 
         glas_cell_binary_slice(buf, len, 
             glas_cell_fptr((void*)buf, pin, false)));
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 API void glas_thread_set_debug_name(glas* g, char const* debug_name) {
     if(NULL == debug_name) { debug_name = ""; }
     size_t const len = strlen(debug_name);
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_binary_push(g, (uint8_t const*) debug_name, len);
     glas_roots_slot_write(&(g->state->gcbase), &(g->state->debug_name),
         glas_thread_stack_pop_cell(g)); 
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 
 
@@ -2996,13 +5111,13 @@ API bool glas_binary_peek_zc(glas*, size_t start_offset, size_t max_read,
     uint8_t const** ppBuf, size_t* amt_read, glas_refct*);
 
 API void glas_ptr_push(glas* g, void* ptr, glas_refct pin, bool linear) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_cell_push(g,
         glas_cell_fptr(ptr, pin, linear));
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 API bool glas_ptr_peek(glas* g, void** ptr, glas_refct* pin) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_prep(g, 1, 0);
     glas_sc* const sc = g->state->stack.data + g->state->stack.count - 1;
     bool const ok = (GLAS_STEM63_EMPTY == sc->stem) &&
@@ -3013,19 +5128,19 @@ API bool glas_ptr_peek(glas* g, void** ptr, glas_refct* pin) {
     } else if(NULL != pin) {
         pin->refct_upd = NULL;
     }
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     if(pin) { 
         glas_incref(*pin); 
     } 
     return ok;
 }
 API bool glas_ptr_pop(glas* g, void** ptr, glas_refct* pin) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     bool ok = glas_ptr_peek(g, ptr, pin);
     if(ok) {
         (void) glas_thread_stack_sc_pop(g);
     }
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 }
 
@@ -3036,15 +5151,15 @@ LOCAL void glas_data_swap_ngc(glas* g) {
     glas_sc* const b = a + 1;
     glas_sc const a_copy = *a;
     glas_roots* const r = &(g->state->gcbase);
-    glas_roots_slot_write(r, &(a->cell), b->cell);
-    glas_roots_slot_write(r, &(b->cell), a_copy.cell);
+    glas_stack_slot_write(r, &(a->cell), b->cell);
+    glas_stack_slot_write(r, &(b->cell), a_copy.cell);
     a->stem = b->stem;
     b->stem = a_copy.stem;
 }
 API void glas_data_swap(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_data_swap_ngc(g);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 LOCAL void glas_data_push_to_stash_ngc(glas* g) {
     // keep the initial implemention simple
@@ -3056,8 +5171,8 @@ LOCAL void glas_data_push_to_stash_ngc(glas* g) {
     glas_sc* const src = &(stack->data[--(stack->count)]);
     glas_sc* const dst = &(stash->data[(stash->count)++]);
     dst->stem = src->stem;
-    glas_roots_slot_write(r, &(dst->cell), src->cell);
-    glas_roots_slot_write(r, &(src->cell), GLAS_VOID);
+    glas_stack_slot_write(r, &(dst->cell), src->cell);
+    glas_stack_slot_write(r, &(src->cell), GLAS_VOID);
 }
 LOCAL void glas_data_pull_from_stash_ngc(glas* g) {
     glas_roots* const r = &(g->state->gcbase);
@@ -3068,22 +5183,25 @@ LOCAL void glas_data_pull_from_stash_ngc(glas* g) {
     glas_sc* const src = &(stash->data[--(stash->count)]);
     glas_sc* const dst = &(stack->data[(stack->count)++]);
     dst->stem = src->stem;
-    glas_roots_slot_write(r, &(dst->cell), src->cell);
-    glas_roots_slot_write(r, &(src->cell), GLAS_VOID);
+    glas_stack_slot_write(r, &(dst->cell), src->cell);
+    glas_stack_slot_write(r, &(src->cell), GLAS_VOID);
 }
-API void glas_data_stash(glas* g, int8_t amt) {
-    if(0 == amt) { return; }
-    glas_os_thread_enter_busy();
+LOCAL void glas_data_stash_ngc(glas* g, int8_t amt) {
     if(amt > 0) {
         do {
             glas_data_push_to_stash_ngc(g);
         } while(0 != --amt);
-    } else {
+    } else if(amt < 0) {
         do {
             glas_data_pull_from_stash_ngc(g);
         } while(0 != ++amt);
     }
-    glas_os_thread_exit_busy();
+}
+API void glas_data_stash(glas* g, int8_t amt) {
+    if(0 == amt) { return; }
+    glas_api_enter(g);
+    glas_data_stash_ngc(g, amt);
+    glas_api_exit(g);
 }
 LOCAL size_t glas_data_copy_lin_ngc(glas* g, uint8_t amt) {
     if(0 == amt) { return 0; }
@@ -3103,9 +5221,9 @@ LOCAL size_t glas_data_copy_lin_ngc(glas* g, uint8_t amt) {
     return amt_linear;
 }
 API void glas_data_copy(glas* g, uint8_t amt) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     size_t const amt_linear = glas_data_copy_lin_ngc(g, amt);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     if(0 != amt_linear) {
         g->err |= GLAS_E_LINEARITY;
     }
@@ -3121,14 +5239,14 @@ LOCAL size_t glas_data_drop_lin_ngc(glas* g, uint8_t amt) {
         if(glas_cell_is_linear(sc->cell)) {
             ++amt_linear;
         }
-        glas_roots_slot_write(r, &(sc->cell), GLAS_VOID);
+        glas_stack_slot_write(r, &(sc->cell), GLAS_VOID);
     }
     return amt_linear;
 }
 API void glas_data_drop(glas* g, uint8_t amt) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     size_t const amt_linear = glas_data_drop_lin_ngc(g, amt);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     if(0 != amt_linear) {
         g->err |= GLAS_E_LINEARITY;
     }
@@ -3146,81 +5264,122 @@ LOCAL bool glas_moves_var_index(uint8_t c, size_t* index) {
         return false;
     }
 }
-LOCAL size_t glas_data_move_lin_ngc(glas* g, uint8_t const* const moves) {
+API bool glas_moves_compile(glas_moves* plan, char const* moves) {
     uint64_t defined = 0; // bitfield for which vars are defined
-    uint8_t copies[64]; // track copy count to detect linearity errors
-    glas_sc data[64]; // using indices 0..51 ('A'-'Z' and 'a'-'z')
-
-    uint8_t const* scan = moves;
-    while('-' != *scan) {
-        // scan to '-', record defined vars, verify structure of LHS
+    uint8_t input[52]; // input position per var, 0 is deepest
+    uint8_t copies[52]; // copy count per var, to precompute linearity checks
+    uint8_t const* scan = (uint8_t const*) moves;
+    size_t in = 0;
+    for(; '-' != *scan; ++scan) {
+        // record defined vars, verify structure of LHS
         size_t ix;
-        if(glas_moves_var_index(*scan, &ix) && (0 == (defined & (UINT64_C(1)<<ix)))) {
-            assert(likely(52 > ix));
-            defined |= (UINT64_C(1)<<ix);
-        } else {
-            debug("invalid moves string: %s", moves);
-            abort();
-        }
-    }
-    uint8_t const* const center = scan; // at '-'
-    while(moves != scan) {
-        // scan backwards, popping stack into local vars
-        --scan;
-        size_t ix;
-        if(glas_moves_var_index(*scan, &ix)) {
-            data[ix] = glas_thread_stack_sc_pop(g);
-            copies[ix] = 0;
+        if(!glas_moves_var_index(*scan, &ix) || (0 != (defined & (UINT64_C(1)<<ix)))) {
+            return false;
         }
+        defined |= (UINT64_C(1)<<ix);
+        input[ix] = (uint8_t) in++;
+        copies[ix] = 0;
     }
-    scan = center + 1;
-    while(0 != *scan) {
-        // scan forwards, pushing vars onto stack, verify structure of RHS
+    size_t out = 0;
+    for(++scan; 0 != *scan; ++scan) {
+        // map outputs to inputs, verify structure of RHS
         size_t ix;
-        if(glas_moves_var_index(*scan, &ix) && (0 != (defined & (UINT64_C(1)<<ix)))) {
-            glas_thread_stack_sc_push(g, data[ix]);
-            copies[ix] = likely(UINT8_MAX > copies[ix]) ? (1 + copies[ix]) : UINT8_MAX;
-        } else {
-            debug("invalid moves string: %s", moves);
-            abort();
+        if(!glas_moves_var_index(*scan, &ix) || (0 == (defined & (UINT64_C(1)<<ix))) ||
+           (GLAS_MOVES_MAX == out)) 
+        {
+            return false;
         }
-        ++scan;
+        plan->src[out++] = input[ix];
+        copies[ix] = likely(UINT8_MAX > copies[ix]) ? (1 + copies[ix]) : UINT8_MAX;
     }
-
-    // check for linearity violations
-    size_t linearity_violations = 0;
+    plan->in = (uint8_t) in;
+    plan->out = (uint8_t) out;
+    plan->linear_check = 0;
     while(0 != defined) {
+        // inputs dropped or copied are checked for linearity
         size_t const ix = ctz64(defined);
         defined &= (defined - 1);
-      #pragma GCC diagnostic push
-      #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-        bool const ok = (1 == copies[ix]) || !glas_cell_is_linear(data[ix].cell);
-      #pragma GCC diagnostic pop
-        linearity_violations += likely(ok) ? 0 : 1;
+        if(1 != copies[ix]) {
+            plan->linear_check |= (UINT64_C(1) << input[ix]);
+        }
+    }
+    return true;
+}
+LOCAL size_t glas_data_move_lin_ngc(glas* g, glas_moves const* plan) {
+    size_t const in = plan->in;
+    size_t const out = plan->out;
+    size_t const reserve = (out > in) ? (out - in) : 0;
+    glas_sc data[52]; // indexed by input position
+    if(likely((in + reserve) < GLAS_STACK_MAX)) {
+        // permute slots in place, touching each slot once
+        glas_thread_stack_prep(g, (uint8_t)in, (uint8_t)reserve);
+        glas_roots* const r = &(g->state->gcbase);
+        glas_stack* const s = &(g->state->stack);
+        glas_sc* const base = s->data + (s->count - in);
+        memcpy(data, base, in * sizeof(glas_sc));
+        for(size_t ix = 0; ix < out; ++ix) {
+            glas_sc const src = data[plan->src[ix]];
+            base[ix].stem = src.stem;
+            if(base[ix].cell != src.cell) {
+                glas_stack_slot_write(r, &(base[ix].cell), src.cell);
+            }
+        }
+        for(size_t ix = out; ix < in; ++ix) {
+            glas_stack_slot_write(r, &(base[ix].cell), GLAS_VOID);
+        }
+        s->count = (s->count - in) + out;
+    } else {
+        // too large to prepare at once; move items one at a time
+        for(size_t ix = in; ix-- > 0; ) {
+            data[ix] = glas_thread_stack_sc_pop(g);
+        }
+        for(size_t ix = 0; ix < out; ++ix) {
+            glas_thread_stack_sc_push(g, data[plan->src[ix]]);
+        }
+    }
+    size_t linearity_violations = 0;
+    uint64_t check = plan->linear_check;
+    while(0 != check) {
+        size_t const ix = ctz64(check);
+        check &= (check - 1);
+        linearity_violations += glas_cell_is_linear(data[ix].cell) ? 1 : 0;
     }
     return linearity_violations;
 }
-
-API void glas_data_move(glas* g, char const* moves) {
-    glas_os_thread_enter_busy();
-    size_t const linearity_violations = 
-        glas_data_move_lin_ngc(g, (uint8_t const*) moves);
-    glas_os_thread_exit_busy();
+API void glas_data_move_exec(glas* g, glas_moves const* plan) {
+    glas_api_enter(g);
+    size_t const linearity_violations = glas_data_move_lin_ngc(g, plan);
+    glas_api_exit(g);
     if(0 != linearity_violations) {
-        debug("moves %s violated linearity of %lu vars", moves, linearity_violations);
+        debug("moves violated linearity of %lu vars", linearity_violations);
         g->err |= GLAS_E_LINEARITY;
     }
 }
+API void glas_data_move(glas* g, char const* moves) {
+    glas_moves plan;
+    if(!glas_moves_compile(&plan, moves)) {
+        debug("invalid moves string: %s", moves);
+        abort();
+    }
+    glas_data_move_exec(g, &plan);
+}
 LOCAL void glas_mkp_ngc(glas* g) {
     glas_sc b = glas_thread_stack_sc_pop(g);
     glas_sc a = glas_thread_stack_sc_pop(g);
     glas_thread_stack_cell_push(g, glas_cell_pair_alloc_sc(a,b));
 }
+LOCAL void glas_mkp_init_ngc(glas* g, glas_cell* cell) {
+    // as glas_mkp_ngc, but into a cell from a batch allocation
+    glas_sc b = glas_thread_stack_sc_pop(g);
+    glas_sc a = glas_thread_stack_sc_pop(g);
+    glas_cell_pair_init_sc(cell, a, b);
+    glas_thread_stack_cell_push(g, cell);
+}
 API void glas_mkp(glas* g) {
     // A B -- (A,B)     ; B is top of stack
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_mkp_ngc(g);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 LOCAL inline void glas_mklr_ngc(glas* g, bool mkr) {
     glas_sc sc = glas_thread_stack_sc_pop(g);
@@ -3228,14 +5387,14 @@ LOCAL inline void glas_mklr_ngc(glas* g, bool mkr) {
     glas_thread_stack_sc_push(g, sc);
 }
 API void glas_mkl(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_mklr_ngc(g, false);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 API void glas_mkr(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_mklr_ngc(g, true);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 LOCAL bool glas_cell_is_pair(glas_cell* cell) {
     if(GLAS_DATA_IS_PTR(cell)) {
@@ -3243,7 +5402,7 @@ LOCAL bool glas_cell_is_pair(glas_cell* cell) {
         #define X(T) (UINT64_C(1)<<T)
         static uint64_t const PAIR_TYPES =
             X(GLAS_TYPE_BIG_ARR) | X(GLAS_TYPE_SMALL_ARR) |
-            X(GLAS_TYPE_BIG_BIN) | X(GLAS_TYPE_SMALL_BIN) |
+            X(GLAS_TYPE_BIG_BIN) | X(GLAS_TYPE_SMALL_BIN) | X(GLAS_TYPE_INT_ARR) |
             X(GLAS_TYPE_TAKE_CONCAT) | X(GLAS_TYPE_BRANCH);
         #undef X
         return (GLAS_STEM31_EMPTY == cell->stemHd) &&
@@ -3256,30 +5415,220 @@ LOCAL bool glas_cell_is_pair(glas_cell* cell) {
         return false;
     }
 }
+LOCAL glas_sc glas_data_u64(uint64_t const n);
+LOCAL glas_cell* glas_cell_take_concat_alloc(uint64_t left_len, glas_cell* left, glas_cell* right) {
+    // list of the first left_len items of left, followed by right
+    assert(likely(0 < left_len));
+    glas_cell* const cell = glas_cell_alloc();
+    cell->hdr.type_id = GLAS_TYPE_TAKE_CONCAT;
+    cell->hdr.type_arg = 0;
+    cell->hdr.type_aggr = glas_type_aggr_comp(
+        glas_cell_type_aggr(left), glas_cell_type_aggr(right));
+    cell->stemHd = GLAS_STEM31_EMPTY;
+    cell->take_concat.left_len = left_len;
+    cell->take_concat.left = left;
+    cell->take_concat.right = right;
+    return cell;
+}
+/**
+ * Balanced ropes. Large lists are trees of take-concat nodes over flat
+ * leaves: binaries, arrays, or any other list encoding we're handed. A
+ * rope node records its height in type_arg and has left_len equal to
+ * the full length of left, thus we index by walking down left_len and
+ * find length by walking the right spine. Height-balanced (AVL-style)
+ * rotations keep these walks logarithmic. Take-concat nodes with zero
+ * type_arg are treated as opaque leaves.
+ *
+ * This is a simpler structure than the 2-3 finger tree described in
+ * GlasObject.md, but it shares the encoding of nodes and leaves, and
+ * it allows for the usual O(log(N)) append, split, and index.
+ */
+LOCAL inline uint8_t glas_rope_height(glas_cell* cell) {
+    return (GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_TAKE_CONCAT == cell->hdr.type_id)) ?
+        cell->hdr.type_arg : 0;
+}
+LOCAL glas_cell* glas_rope_node(uint64_t left_len, glas_cell* left, glas_cell* right) {
+    uint8_t const hl = glas_rope_height(left);
+    uint8_t const hr = glas_rope_height(right);
+    glas_cell* const cell = glas_cell_take_concat_alloc(left_len, left, right);
+    cell->hdr.type_arg = 1 + ((hl > hr) ? hl : hr);
+    return cell;
+}
+LOCAL glas_cell* glas_rope_balance(uint64_t left_len, glas_cell* left, glas_cell* right) {
+    // build a node, rotating if heights differ by more than one. 
+    uint8_t const hl = glas_rope_height(left);
+    uint8_t const hr = glas_rope_height(right);
+    if(hl > (hr + 1)) {
+        uint64_t const ll_len = left->take_concat.left_len;
+        glas_cell* const ll = left->take_concat.left;
+        glas_cell* const lr = left->take_concat.right;
+        if(glas_rope_height(lr) > glas_rope_height(ll)) {
+            uint64_t const lrl_len = lr->take_concat.left_len;
+            return glas_rope_node(ll_len + lrl_len,
+                glas_rope_node(ll_len, ll, lr->take_concat.left),
+                glas_rope_node(left_len - (ll_len + lrl_len), lr->take_concat.right, right));
+        }
+        return glas_rope_node(ll_len, ll, glas_rope_node(left_len - ll_len, lr, right));
+    } else if(hr > (hl + 1)) {
+        uint64_t const rl_len = right->take_concat.left_len;
+        glas_cell* const rl = right->take_concat.left;
+        glas_cell* const rr = right->take_concat.right;
+        if(glas_rope_height(rl) > glas_rope_height(rr)) {
+            uint64_t const rll_len = rl->take_concat.left_len;
+            return glas_rope_node(left_len + rll_len,
+                glas_rope_node(left_len, left, rl->take_concat.left),
+                glas_rope_node(rl_len - rll_len, rl->take_concat.right, rr));
+        }
+        return glas_rope_node(left_len + rl_len, glas_rope_node(left_len, left, rl), rr);
+    }
+    return glas_rope_node(left_len, left, right);
+}
+LOCAL glas_sc glas_shrub_to_sc(uint64_t shrub) {
+    // normalize: unit and edge-only shrubs become bits
+    glas_sc sc = { .stem = GLAS_STEM63_EMPTY, .cell = GLAS_VAL_UNIT };
+    uint64_t bits = 0;
+    size_t len = 0;
+    uint64_t rem = shrub;
+    while(GLAS_SHRUB_IS_EDGE(rem)) {
+        bits = (bits << 1) | (GLAS_SHRUB_IS_INR(rem) ? 1 : 0);
+        len++;
+        rem = rem << 2;
+    }
+    if(0 == rem) {
+        sc.stem = ((bits << 1) | 1) << (63 - len);
+    } else {
+        sc.cell = (glas_cell*)(shrub | GLAS_DATA_TAG_SHRUB);
+    }
+    return sc;
+}
+LOCAL void glas_shrub_split_pair(uint64_t shrub, glas_sc* outl, glas_sc* outr) {
+    // shrub is `01 Left 00 Right`, Left and Right are shrubs
+    assert(likely(GLAS_SHRUB_IS_PAIR(shrub)));
+    uint64_t const body = shrub << 2;
+    // Left is body up to the matching separator, cf. glas_shrub_skip_elem
+    uint64_t rem = body;
+    size_t pairs_rem = 0;
+    size_t steps = 0;
+    do {
+        if(GLAS_SHRUB_IS_PSEP(rem)) {
+            if(0 == pairs_rem) { break; }
+            pairs_rem--;
+        } else if(GLAS_SHRUB_IS_PAIR(rem)) {
+            pairs_rem++;
+        }
+        rem = rem << 2;
+        ++steps;
+    } while(1);
+    uint64_t const left = (0 == steps) ? 0 : (body & (~UINT64_C(0) << (64 - (2 * steps))));
+    (*outl) = glas_shrub_to_sc(left);
+    (*outr) = glas_shrub_to_sc(rem << 2);
+}
 LOCAL void glas_cell_split_pair(glas_cell* cell, glas_sc* outl, glas_sc* outr) {
-    // assume valid pair
+    // assume valid pair. Lists share buffers with the source, so walking
+    // a binary or array is O(1) per step.
+    static glas_sc const unit = { .stem = GLAS_STEM63_EMPTY, .cell = GLAS_VAL_UNIT };
     if(GLAS_DATA_IS_PTR(cell)) {
         assert(likely(GLAS_STEM31_EMPTY == cell->stemHd));
         switch(cell->hdr.type_id) {
-            case GLAS_TYPE_BRANCH:
-
-            case GLAS_TYPE_SMALL_ARR:
-            case GLAS_TYPE_BIG_ARR:
-            case GLAS_TYPE_SMALL_BIN:
-            case GLAS_TYPE_BIG_BIN:
-            case GLAS_TYPE_TAKE_CONCAT:
+            case GLAS_TYPE_BRANCH: {
+                outl->stem = ((uint64_t)cell->branch.stemL) << 32;
+                outl->cell = cell->branch.L;
+                outr->stem = ((uint64_t)cell->branch.stemR) << 32;
+                outr->cell = cell->branch.R;
+                return;
+            }
+            case GLAS_TYPE_SMALL_ARR: {
+                size_t const len = cell->hdr.type_arg;
+                assert(likely(0 < len));
+                outl->stem = GLAS_STEM63_EMPTY;
+                outl->cell = cell->small_arr[0];
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = glas_cell_array_alloc(cell->small_arr + 1, len - 1);
+                return;
+            }
+            case GLAS_TYPE_BIG_ARR: {
+                glas_cell** const data = cell->big_arr.data;
+                size_t const len = cell->big_arr.len;
+                assert(likely(0 < len));
+                outl->stem = GLAS_STEM63_EMPTY;
+                outl->cell = data[0];
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = ((len - 1) < 4) ? glas_cell_array_alloc(data + 1, len - 1) :
+                    glas_cell_array_slice(data + 1, len - 1, cell->hdr.type_aggr, cell->big_arr.fptr);
+                return;
+            }
+            case GLAS_TYPE_SMALL_BIN: {
+                size_t const len = cell->hdr.type_arg;
+                assert(likely(0 < len));
+                (*outl) = glas_data_u64(cell->small_bin[0]);
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = glas_cell_binary_alloc(cell->small_bin + 1, len - 1);
+                return;
+            }
+            case GLAS_TYPE_BIG_BIN: {
+                uint8_t const* const data = cell->big_bin.data;
+                size_t const len = cell->big_bin.len;
+                assert(likely(0 < len));
+                (*outl) = glas_data_u64(data[0]);
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = ((len - 1) <= 24) ? glas_cell_binary_alloc(data + 1, len - 1) :
+                    glas_cell_binary_slice(data + 1, len - 1, cell->big_bin.fptr);
+                return;
+            }
+            case GLAS_TYPE_INT_ARR: {
+                uint8_t const width = cell->hdr.type_arg;
+                uint8_t const* const data = cell->int_arr.data;
+                size_t const len = cell->int_arr.len;
+                assert(likely(0 < len));
+                (*outl) = glas_data_i64(glas_int_arr_get(cell, 0));
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = ((len - 1) < 4) ? 
+                    glas_cell_int_array_alloc(data + ((size_t)1 << width), len - 1, width) :
+                    glas_cell_int_array_slice(data + ((size_t)1 << width), len - 1, width, 
+                        cell->int_arr.fptr);
+                return;
+            }
+            case GLAS_TYPE_TAKE_CONCAT: {
+                uint64_t const left_len = cell->take_concat.left_len;
+                if(0 == left_len) {
+                    glas_cell_split_pair(cell->take_concat.right, outl, outr);
+                    return;
+                }
+                glas_sc tail;
+                glas_cell_split_pair(cell->take_concat.left, outl, &tail);
+                outr->stem = GLAS_STEM63_EMPTY;
+                outr->cell = (1 == left_len) ? cell->take_concat.right :
+                    (0 != cell->hdr.type_arg) ? 
+                    glas_rope_balance(left_len - 1, glas_sc_to_cell(tail),
+                        cell->take_concat.right) :
+                    glas_cell_take_concat_alloc(left_len - 1, glas_sc_to_cell(tail), 
+                        cell->take_concat.right);
+                return;
+            }
+            default:
+                break;
         }
         debug("unsupported pair type: %d", (int) cell->hdr.type_id);
         abort();
     } else if(GLAS_DATA_IS_BINARY(cell)) {
-
+        // packed list of 1..7 bytes, first byte in high bits
+        uint64_t const p = (uint64_t) cell;
+        size_t const len = GLAS_DATA_BINARY_LEN(p);
+        assert(likely(0 < len));
+        (*outl) = glas_data_u64(p >> 56);
+        if(1 == len) {
+            (*outr) = unit;
+        } else {
+            outr->stem = GLAS_STEM63_EMPTY;
+            outr->cell = (glas_cell*)(((p & ~UINT64_C(0xFF)) << 8) | 
+                (((uint64_t)(len - 1)) << 5) | GLAS_DATA_TAG_BINARY);
+        }
     } else if(GLAS_DATA_IS_SHRUB(cell)) {
-        
+        glas_shrub_split_pair(GLAS_DATA_SHRUB_BITS(cell), outl, outr);
+    } else {
+        debug("not a pair: %p", (void*) cell);
+        abort();
     }
-
-    (void)cell; (void)outl; (void)outr;
-    debug("todo: split pair");
-    abort();
 }
 LOCAL bool glas_unp_ngc(glas* g) {
     glas_thread_stack_prep(g, 1, 1);
@@ -3296,28 +5645,608 @@ LOCAL bool glas_unp_ngc(glas* g) {
     return true;
 }
 API bool glas_unp(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     bool ok = glas_unp_ngc(g);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 }
 
+/**
+ * List operations over ropes. Leaves are coalesced when small, or when
+ * they are adjacent slices of the same buffer. Cons lists and shrubs are
+ * accepted as leaves, but are walked in linear time and flattened into
+ * arrays when split.
+ */
+#define GLAS_ROPE_LEAF_ITEMS 32     // coalesce up to this many items
+#define GLAS_ROPE_LEAF_BYTES 256    // or this many bytes for binaries
+LOCAL bool glas_list_len_cell(glas_cell* cell, uint64_t* len) {
+    // add list length to len, walking the right spine of ropes
+    uint64_t n = 0;
+    do {
+        if(GLAS_DATA_IS_PTR(cell)) {
+            if(GLAS_STEM31_EMPTY != cell->stemHd) {
+                return false;
+            }
+            switch(cell->hdr.type_id) {
+                case GLAS_TYPE_BRANCH:
+                    if(GLAS_STEM31_EMPTY != cell->branch.stemR) {
+                        return false;
+                    }
+                    ++n;
+                    cell = cell->branch.R;
+                    continue;
+                case GLAS_TYPE_TAKE_CONCAT:
+                    n += cell->take_concat.left_len;
+                    cell = cell->take_concat.right;
+                    continue;
+                case GLAS_TYPE_BIG_ARR: n += cell->big_arr.len; break;
+                case GLAS_TYPE_BIG_BIN: n += cell->big_bin.len; break;
+                case GLAS_TYPE_INT_ARR: n += cell->int_arr.len; break;
+                case GLAS_TYPE_SMALL_ARR:
+                case GLAS_TYPE_SMALL_BIN: n += cell->hdr.type_arg; break;
+                default: return false; // TBD: force thunks or extrefs
+            }
+        } else if(GLAS_DATA_IS_BINARY(cell)) {
+            n += GLAS_DATA_BINARY_LEN(cell);
+        } else if(GLAS_DATA_IS_SHRUB(cell)) {
+            uint64_t shrub = GLAS_DATA_SHRUB_BITS(cell);
+            while(GLAS_SHRUB_IS_PAIR(shrub)) {
+                ++n;
+                shrub = glas_shrub_skip_elem(shrub << 2);
+            }
+            if(!GLAS_SHRUB_IS_UNIT(shrub)) { return false; }
+        } else if(GLAS_VAL_UNIT != cell) {
+            return false;
+        }
+        (*len) += n;
+        return true;
+    } while(1);
+}
+LOCAL inline bool glas_sc_list_len(glas_sc sc, uint64_t* len) {
+    return (GLAS_STEM63_EMPTY == sc.stem) && glas_list_len_cell(sc.cell, len);
+}
+LOCAL bool glas_list_leaf_bytes(glas_cell* cell, uint8_t const** data, uint8_t* tmp) {
+    // flat binary leaves; tmp holds up to 7 bytes from a packed binary
+    if(GLAS_DATA_IS_BINARY(cell)) {
+        uint64_t const p = (uint64_t) cell;
+        size_t const len = GLAS_DATA_BINARY_LEN(p);
+        for(size_t ix = 0; ix < len; ++ix) {
+            tmp[ix] = (uint8_t)(p >> (56 - (8 * ix)));
+        }
+        (*data) = tmp;
+        return true;
+    } else if(!GLAS_DATA_IS_PTR(cell)) {
+        return false;
+    } else if(GLAS_TYPE_SMALL_BIN == cell->hdr.type_id) {
+        (*data) = cell->small_bin;
+        return true;
+    } else if(GLAS_TYPE_BIG_BIN == cell->hdr.type_id) {
+        (*data) = cell->big_bin.data;
+        return true;
+    }
+    return false;
+}
+LOCAL inline glas_cell** glas_list_leaf_items(glas_cell* cell) {
+    // flat array leaves, or NULL
+    if(!GLAS_DATA_IS_PTR(cell)) { return NULL; }
+    if(GLAS_TYPE_SMALL_ARR == cell->hdr.type_id) { return cell->small_arr; }
+    if(GLAS_TYPE_BIG_ARR == cell->hdr.type_id) { return cell->big_arr.data; }
+    return NULL;
+}
+LOCAL inline bool glas_cell_is_int_arr(glas_cell* cell) {
+    return GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_INT_ARR == cell->hdr.type_id);
+}
+LOCAL inline bool glas_rope_leaf_small(glas_cell* cell, uint64_t len) {
+    uint8_t tmp[8];
+    uint8_t const* data;
+    return (0 == glas_rope_height(cell)) && ((len <= GLAS_ROPE_LEAF_ITEMS) || 
+        ((len <= GLAS_ROPE_LEAF_BYTES) && glas_list_leaf_bytes(cell, &data, tmp)) ||
+        (glas_cell_is_int_arr(cell) && ((len << cell->hdr.type_arg) <= GLAS_ROPE_LEAF_BYTES)));
+}
+LOCAL inline bool glas_rope_leaf_is_flat(glas_cell* cell) {
+    uint8_t tmp[8];
+    uint8_t const* data;
+    return (NULL != glas_list_leaf_items(cell)) || glas_cell_is_int_arr(cell) || 
+           glas_list_leaf_bytes(cell, &data, tmp);
+}
+LOCAL glas_cell* glas_rope_leaf_sub(glas_cell* cell, uint64_t offset, uint64_t len) {
+    // sublist of a flat leaf, sharing big buffers
+    uint8_t tmp[8];
+    uint8_t const* data;
+    if(glas_cell_is_int_arr(cell)) {
+        uint8_t const width = cell->hdr.type_arg;
+        uint8_t const* const base = ((uint8_t const*)cell->int_arr.data) + (offset << width);
+        return (len >= 4) ? glas_cell_int_array_slice(base, len, width, cell->int_arr.fptr) :
+                            glas_cell_int_array_alloc(base, len, width);
+    }
+    if(glas_list_leaf_bytes(cell, &data, tmp)) {
+        bool const share = (len > 24) && (GLAS_TYPE_BIG_BIN == cell->hdr.type_id);
+        return share ? glas_cell_binary_slice(data + offset, len, cell->big_bin.fptr) :
+                       glas_cell_binary_alloc(data + offset, len);
+    }
+    glas_cell** const items = glas_list_leaf_items(cell);
+    assert(likely(NULL != items));
+    bool const share = (len >= 4) && (GLAS_TYPE_BIG_ARR == cell->hdr.type_id);
+    return share ? glas_cell_array_slice(items + offset, len, cell->hdr.type_aggr, cell->big_arr.fptr) :
+                   glas_cell_array_alloc(items + offset, len);
+}
+LOCAL glas_cell* glas_rope_walk(glas_cell* cell, uint64_t len, glas_cell** dst) {
+    // copy len items from head of list into dst, returning the remainder
+    for(uint64_t ix = 0; ix < len; ++ix) {
+        glas_sc hd, tl;
+        glas_cell_split_pair(cell, &hd, &tl);
+        assert(likely(GLAS_STEM63_EMPTY == tl.stem));
+        dst[ix] = glas_sc_to_cell(hd);
+        cell = tl.cell;
+    }
+    return cell;
+}
+LOCAL void glas_rope_leaf_gather(glas_cell* cell, uint64_t len, glas_cell** dst) {
+    uint8_t tmp[8];
+    uint8_t const* data;
+    glas_cell** const items = glas_list_leaf_items(cell);
+    if(NULL != items) {
+        memcpy(dst, items, len * sizeof(glas_cell*));
+    } else if(glas_list_leaf_bytes(cell, &data, tmp)) {
+        for(uint64_t ix = 0; ix < len; ++ix) {
+            dst[ix] = glas_sc_to_cell(glas_data_u64(data[ix]));
+        }
+    } else if(glas_cell_is_int_arr(cell)) {
+        for(uint64_t ix = 0; ix < len; ++ix) {
+            dst[ix] = glas_sc_to_cell(glas_data_i64(glas_int_arr_get(cell, ix)));
+        }
+    } else {
+        glas_rope_walk(cell, len, dst);
+    }
+}
+LOCAL bool glas_i64_peek_sc(glas_sc* osc, int64_t* n);
+LOCAL bool glas_rope_leaf_ints(glas_cell* cell, uint64_t len, int64_t* dst) {
+    // read a small leaf as integers, or return false
+    uint8_t tmp[8];
+    uint8_t const* data;
+    if(glas_cell_is_int_arr(cell)) {
+        for(uint64_t ix = 0; ix < len; ++ix) { dst[ix] = glas_int_arr_get(cell, ix); }
+        return true;
+    } else if(glas_list_leaf_bytes(cell, &data, tmp)) {
+        for(uint64_t ix = 0; ix < len; ++ix) { dst[ix] = data[ix]; }
+        return true;
+    } else if(len > GLAS_ROPE_LEAF_ITEMS) {
+        return false;
+    }
+    glas_cell* items[GLAS_ROPE_LEAF_ITEMS];
+    glas_rope_leaf_gather(cell, len, items);
+    for(uint64_t ix = 0; ix < len; ++ix) {
+        glas_sc sc = { .stem = GLAS_STEM63_EMPTY, .cell = items[ix] };
+        if(!glas_i64_peek_sc(&sc, dst + ix)) { return false; }
+    }
+    return true;
+}
+LOCAL inline uint8_t glas_int_width(int64_t n) {
+    return ((INT8_MIN <= n) && (n <= INT8_MAX)) ? 0 :
+           ((INT16_MIN <= n) && (n <= INT16_MAX)) ? 1 :
+           ((INT32_MIN <= n) && (n <= INT32_MAX)) ? 2 : 3;
+}
+LOCAL inline void glas_int_buf_set(void* data, uint8_t width, size_t ix, int64_t n) {
+    switch(width) {
+        case 0: ((int8_t*)data)[ix] = (int8_t)n; return;
+        case 1: ((int16_t*)data)[ix] = (int16_t)n; return;
+        case 2: ((int32_t*)data)[ix] = (int32_t)n; return;
+        default: ((int64_t*)data)[ix] = n; return;
+    }
+}
+LOCAL glas_cell* glas_rope_leaf_of_ints(int64_t const* ints, size_t len) {
+    // binary if every item is a byte, else the narrowest int array that
+    // fits the leaf budget, or NULL
+    int64_t lo = 0, hi = 0;
+    for(size_t ix = 0; ix < len; ++ix) {
+        if(ints[ix] < lo) { lo = ints[ix]; }
+        if(ints[ix] > hi) { hi = ints[ix]; }
+    }
+    if((0 == lo) && (hi <= UINT8_MAX)) {
+        uint8_t buf[GLAS_ROPE_LEAF_BYTES];
+        for(size_t ix = 0; ix < len; ++ix) { buf[ix] = (uint8_t) ints[ix]; }
+        return glas_cell_binary_alloc(buf, len);
+    }
+    uint8_t const wlo = glas_int_width(lo);
+    uint8_t const whi = glas_int_width(hi);
+    uint8_t const width = (wlo > whi) ? wlo : whi;
+    if((len << width) > GLAS_ROPE_LEAF_BYTES) { return NULL; }
+    int64_t buf[GLAS_ROPE_LEAF_BYTES / sizeof(int64_t)];
+    for(size_t ix = 0; ix < len; ++ix) { glas_int_buf_set(buf, width, ix, ints[ix]); }
+    return glas_cell_int_array_alloc(buf, len, width);
+}
+LOCAL glas_cell* glas_rope_leaf_merge(glas_cell* l, uint64_t llen, glas_cell* r, uint64_t rlen) {
+    // coalesce adjacent leaves, or return NULL
+    if((0 != glas_rope_height(l)) || (0 != glas_rope_height(r))) {
+        return NULL;
+    }
+    uint64_t const len = llen + rlen;
+    if(GLAS_DATA_IS_PTR(l) && GLAS_DATA_IS_PTR(r) && (l->hdr.type_id == r->hdr.type_id)) {
+        // rejoin aligned slices of one buffer, or the buffer itself
+        if((GLAS_TYPE_BIG_BIN == l->hdr.type_id) && (l->big_bin.fptr == r->big_bin.fptr) &&
+           ((l->big_bin.data + llen) == r->big_bin.data))
+        {
+            glas_cell* const owner = l->big_bin.fptr;
+            bool const whole = (GLAS_TYPE_BIG_BIN == owner->hdr.type_id) &&
+                (owner->big_bin.data == l->big_bin.data) && (owner->big_bin.len == len);
+            return whole ? owner : glas_cell_binary_slice(l->big_bin.data, len, owner);
+        }
+        if((GLAS_TYPE_BIG_ARR == l->hdr.type_id) && (l->big_arr.fptr == r->big_arr.fptr) &&
+           ((l->big_arr.data + llen) == r->big_arr.data))
+        {
+            glas_cell* const owner = l->big_arr.fptr;
+            bool const whole = (GLAS_TYPE_BIG_ARR == owner->hdr.type_id) &&
+                (owner->big_arr.data == l->big_arr.data) && (owner->big_arr.len == len);
+            return whole ? owner : glas_cell_array_slice(l->big_arr.data, len,
+                glas_type_aggr_comp(l->hdr.type_aggr, r->hdr.type_aggr), owner);
+        }
+        if((GLAS_TYPE_INT_ARR == l->hdr.type_id) && (l->int_arr.fptr == r->int_arr.fptr) &&
+           (l->hdr.type_arg == r->hdr.type_arg) &&
+           ((((uint8_t const*)l->int_arr.data) + (llen << l->hdr.type_arg)) == r->int_arr.data))
+        {
+            glas_cell* const owner = l->int_arr.fptr;
+            bool const whole = (GLAS_TYPE_INT_ARR == owner->hdr.type_id) &&
+                (owner->int_arr.data == l->int_arr.data) && (owner->int_arr.len == len);
+            return whole ? owner : 
+                glas_cell_int_array_slice(l->int_arr.data, len, l->hdr.type_arg, owner);
+        }
+    }
+    uint8_t ltmp[8], rtmp[8];
+    uint8_t const *ldata, *rdata;
+    if((len <= GLAS_ROPE_LEAF_BYTES) && glas_list_leaf_bytes(l, &ldata, ltmp) && 
+        glas_list_leaf_bytes(r, &rdata, rtmp)) 
+    {
+        uint8_t buf[GLAS_ROPE_LEAF_BYTES];
+        memcpy(buf, ldata, llen);
+        memcpy(buf + llen, rdata, rlen);
+        return glas_cell_binary_alloc(buf, len);
+    }
+    if((len <= GLAS_ROPE_LEAF_BYTES) && ((len <= GLAS_ROPE_LEAF_ITEMS) || 
+        glas_cell_is_int_arr(l) || glas_cell_is_int_arr(r)))
+    {
+        // lists of integers are unboxed
+        int64_t ints[GLAS_ROPE_LEAF_BYTES];
+        if(glas_rope_leaf_ints(l, llen, ints) && glas_rope_leaf_ints(r, rlen, ints + llen)) {
+            glas_cell* const cell = glas_rope_leaf_of_ints(ints, len);
+            if(NULL != cell) { return cell; }
+        }
+    }
+    if(len <= GLAS_ROPE_LEAF_ITEMS) {
+        glas_cell* buf[GLAS_ROPE_LEAF_ITEMS];
+        glas_rope_leaf_gather(l, llen, buf);
+        glas_rope_leaf_gather(r, rlen, buf + llen);
+        return glas_cell_array_alloc(buf, len);
+    }
+    return NULL;
+}
+LOCAL glas_cell* glas_rope_join(glas_cell* l, uint64_t llen, glas_cell* r, uint64_t rlen) {
+    // concatenate lists of known length. Small leaves are pushed down
+    // the spine of the larger rope, so they may coalesce with its edge.
+    if(0 == llen) { return r; }
+    if(0 == rlen) { return l; }
+    glas_cell* const merged = glas_rope_leaf_merge(l, llen, r, rlen);
+    if(NULL != merged) { return merged; }
+    uint8_t const hl = glas_rope_height(l);
+    uint8_t const hr = glas_rope_height(r);
+    if((hl > (hr + 1)) || ((0 != hl) && glas_rope_leaf_small(r, rlen))) {
+        uint64_t const ll_len = l->take_concat.left_len;
+        glas_cell* const lr = glas_rope_join(l->take_concat.right, llen - ll_len, r, rlen);
+        return glas_rope_balance(ll_len, l->take_concat.left, lr);
+    } else if((hr > (hl + 1)) || ((0 != hr) && glas_rope_leaf_small(l, llen))) {
+        uint64_t const rl_len = r->take_concat.left_len;
+        glas_cell* const rl = glas_rope_join(l, llen, r->take_concat.left, rl_len);
+        return glas_rope_balance(llen + rl_len, rl, r->take_concat.right);
+    }
+    return glas_rope_node(llen, l, r);
+}
+LOCAL void glas_rope_split(glas_cell* cell, uint64_t len, uint64_t at, 
+    glas_cell** outl, glas_cell** outr)
+{
+    // split list of len items at index 0..len
+    assert(likely(at <= len));
+    if(0 == at) {
+        (*outl) = GLAS_VAL_UNIT;
+        (*outr) = cell;
+    } else if(len == at) {
+        (*outl) = cell;
+        (*outr) = GLAS_VAL_UNIT;
+    } else if(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_TAKE_CONCAT == cell->hdr.type_id)) {
+        uint64_t const left_len = cell->take_concat.left_len;
+        glas_cell* left = cell->take_concat.left;
+        glas_cell* const right = cell->take_concat.right;
+        if(0 == cell->hdr.type_arg) {
+            // plain take-concat; take the prefix, then split as a rope node
+            uint64_t full = 0;
+            bool const ok = glas_list_len_cell(left, &full);
+            assert(likely(ok && (full >= left_len)));
+            (void)ok;
+            glas_cell* unused;
+            glas_rope_split(left, full, left_len, &left, &unused);
+        }
+        glas_cell *a, *b;
+        if(at < left_len) {
+            glas_rope_split(left, left_len, at, &a, &b);
+            (*outl) = a;
+            (*outr) = glas_rope_join(b, left_len - at, right, len - left_len);
+        } else {
+            glas_rope_split(right, len - left_len, at - left_len, &a, &b);
+            (*outl) = glas_rope_join(left, left_len, a, at - left_len);
+            (*outr) = b;
+        }
+    } else if(glas_rope_leaf_is_flat(cell)) {
+        (*outl) = glas_rope_leaf_sub(cell, 0, at);
+        (*outr) = glas_rope_leaf_sub(cell, at, len - at);
+    } else {
+        // cons lists, shrubs, etc.; flatten the prefix into an array
+        glas_cell* local[GLAS_ROPE_LEAF_ITEMS];
+        glas_cell** const buf = (at > GLAS_ROPE_LEAF_ITEMS) ? 
+            malloc(at * sizeof(glas_cell*)) : local;
+        (*outr) = glas_rope_walk(cell, at, buf);
+        (*outl) = glas_cell_array_alloc(buf, at);
+        if(buf != local) { free(buf); }
+    }
+}
+LOCAL glas_sc glas_rope_index(glas_cell* cell, uint64_t ix) {
+    // assumes ix is within the list
+    do {
+        if(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_TAKE_CONCAT == cell->hdr.type_id)) {
+            uint64_t const left_len = cell->take_concat.left_len;
+            if(ix < left_len) {
+                cell = cell->take_concat.left;
+            } else {
+                ix -= left_len;
+                cell = cell->take_concat.right;
+            }
+            continue;
+        }
+        uint8_t tmp[8];
+        uint8_t const* data;
+        glas_cell** const items = glas_list_leaf_items(cell);
+        if(NULL != items) {
+            glas_sc const sc = { .stem = GLAS_STEM63_EMPTY, .cell = items[ix] };
+            return sc;
+        } else if(glas_cell_is_int_arr(cell)) {
+            return glas_data_i64(glas_int_arr_get(cell, ix));
+        } else if(glas_list_leaf_bytes(cell, &data, tmp)) {
+            return glas_data_u64(data[ix]);
+        }
+        glas_sc hd, tl;
+        glas_cell_split_pair(cell, &hd, &tl);
+        if(0 == ix) { return hd; }
+        --ix;
+        cell = tl.cell;
+    } while(1);
+}
+LOCAL bool glas_u64_peek_sc(glas_sc* osc, uint64_t* n);
+API void glas_list_append(glas* g) {
+    // L R -- (L++R)
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 2, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const l = s->data[s->count - 2];
+    glas_sc const r = s->data[s->count - 1];
+    uint64_t llen = 0, rlen = 0;
+    bool const ok = glas_sc_list_len(l, &llen) && glas_sc_list_len(r, &rlen);
+    if(ok) {
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_cell_push(g, glas_rope_join(l.cell, llen, r.cell, rlen));
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_list_split(glas* g) {
+    // (L++R) N -- L R
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 2, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const lr = s->data[s->count - 2];
+    glas_sc n = s->data[s->count - 1];
+    uint64_t len = 0, at = 0;
+    bool const ok = glas_sc_list_len(lr, &len) && glas_u64_peek_sc(&n, &at) && (at <= len);
+    if(ok) {
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_pop(g);
+        glas_cell *l, *r;
+        glas_rope_split(lr.cell, len, at, &l, &r);
+        glas_thread_stack_cell_push(g, l);
+        glas_thread_stack_cell_push(g, r);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_list_index(glas* g) {
+    // L N -- L X
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 2, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const l = s->data[s->count - 2];
+    glas_sc n = s->data[s->count - 1];
+    uint64_t len = 0, ix = 0;
+    bool const ok = glas_sc_list_len(l, &len) && glas_u64_peek_sc(&n, &ix) && (ix < len);
+    bool linear = false;
+    if(ok) {
+        glas_sc const x = glas_rope_index(l.cell, ix);
+        linear = glas_cell_is_linear(x.cell);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_push(g, x);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    } else if(linear) {
+        g->err |= GLAS_E_LINEARITY;
+    }
+}
+LOCAL glas_cell* glas_rope_leaf_at(glas_cell* cell, uint64_t* ix, uint64_t* avail) {
+    // descend to the leaf holding item ix. Then ix is the offset within
+    // that leaf, and avail is reduced to the items remaining in the leaf.
+    while(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_TAKE_CONCAT == cell->hdr.type_id)) {
+        uint64_t const left_len = cell->take_concat.left_len;
+        if((*ix) < left_len) {
+            if((left_len - (*ix)) < (*avail)) { (*avail) = left_len - (*ix); }
+            cell = cell->take_concat.left;
+        } else {
+            (*ix) -= left_len;
+            cell = cell->take_concat.right;
+        }
+    }
+    return cell;
+}
+LOCAL size_t glas_rope_leaf_read_i64(glas_cell** pcell, uint64_t offset, size_t amt, int64_t* dst) {
+    // read up to amt integers from a leaf, stopping at a non-integer. For
+    // a cons list, *pcell advances past the items read, so the caller may
+    // resume from there at offset 0 instead of walking the list again.
+    glas_cell* cell = (*pcell);
+    uint8_t tmp[8];
+    uint8_t const* data;
+    glas_cell** const items = glas_list_leaf_items(cell);
+    if(glas_cell_is_int_arr(cell)) {
+        for(size_t ix = 0; ix < amt; ++ix) { dst[ix] = glas_int_arr_get(cell, offset + ix); }
+        return amt;
+    } else if(glas_list_leaf_bytes(cell, &data, tmp)) {
+        for(size_t ix = 0; ix < amt; ++ix) { dst[ix] = data[offset + ix]; }
+        return amt;
+    } else if(NULL != items) {
+        for(size_t ix = 0; ix < amt; ++ix) {
+            glas_sc sc = { .stem = GLAS_STEM63_EMPTY, .cell = items[offset + ix] };
+            if(!glas_i64_peek_sc(&sc, dst + ix)) { return ix; }
+        }
+        return amt;
+    }
+    glas_sc hd, tl;
+    for(uint64_t ix = 0; ix < offset; ++ix) {
+        glas_cell_split_pair(cell, &hd, &tl);
+        cell = tl.cell;
+    }
+    for(size_t ix = 0; ix < amt; ++ix) {
+        glas_cell_split_pair(cell, &hd, &tl);
+        if(!glas_i64_peek_sc(&hd, dst + ix)) { return ix; }
+        cell = tl.cell;
+    }
+    (*pcell) = cell;
+    return amt;
+}
+LOCAL bool glas_int_array_peek(glas* g, size_t start_offset, size_t max_read, 
+    void* buf, uint8_t width, size_t* amt_read)
+{
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 1, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const sc = s->data[s->count - 1];
+    int64_t const hi = (int64_t)(UINT64_MAX >> (64 - (8 << width) + 1));
+    int64_t const lo = -hi - 1;
+    uint64_t len = 0;
+    size_t amt = 0;
+    bool const ok = glas_sc_list_len(sc, &len);
+    size_t const want = (!ok || (start_offset >= len)) ? 0 :
+        ((len - start_offset) < max_read) ? (size_t)(len - start_offset) : max_read;
+    glas_cell* cursor = NULL; // within a cons leaf, at item start_offset + amt
+    uint64_t cursor_avail = 0;
+    while(amt < want) {
+        uint64_t ix = start_offset + amt;
+        uint64_t avail = want - amt;
+        glas_cell* leaf;
+        if(NULL != cursor) {
+            leaf = cursor;
+            ix = 0;
+            avail = cursor_avail;
+        } else {
+            leaf = glas_rope_leaf_at(sc.cell, &ix, &avail);
+        }
+        if((NULL != buf) && glas_cell_is_int_arr(leaf) && (width == leaf->hdr.type_arg)) {
+            // same width, a plain copy
+            memcpy(((uint8_t*)buf) + (amt << width),
+                ((uint8_t const*)leaf->int_arr.data) + (ix << width), avail << width);
+            amt += avail;
+            continue;
+        }
+        int64_t chunk[256];
+        size_t const n = (avail < 256) ? (size_t)avail : 256;
+        bool const flat = glas_rope_leaf_is_flat(leaf);
+        size_t const got = glas_rope_leaf_read_i64(&leaf, ix, n, chunk);
+        size_t k = 0;
+        while((k < got) && (lo <= chunk[k]) && (chunk[k] <= hi)) {
+            if(NULL != buf) { glas_int_buf_set(buf, width, amt + k, chunk[k]); }
+            ++k;
+        }
+        amt += k;
+        if(k < n) { break; }
+        cursor = (!flat && (avail > n)) ? leaf : NULL;
+        cursor_avail = avail - n;
+    }
+    glas_api_exit(g);
+    if(NULL != amt_read) { (*amt_read) = amt; }
+    return ok && ((start_offset + amt) >= len);
+}
+API bool glas_i64_array_peek(glas* g, size_t start_offset, size_t max_read, 
+    int64_t* buf, size_t* amt_read) 
+{
+    return glas_int_array_peek(g, start_offset, max_read, buf, 3, amt_read);
+}
+API bool glas_i32_array_peek(glas* g, size_t start_offset, size_t max_read, 
+    int32_t* buf, size_t* amt_read) 
+{
+    return glas_int_array_peek(g, start_offset, max_read, buf, 2, amt_read);
+}
+API bool glas_i16_array_peek(glas* g, size_t start_offset, size_t max_read, 
+    int16_t* buf, size_t* amt_read) 
+{
+    return glas_int_array_peek(g, start_offset, max_read, buf, 1, amt_read);
+}
+API bool glas_i8_array_peek(glas* g, size_t start_offset, size_t max_read, 
+    int8_t* buf, size_t* amt_read) 
+{
+    return glas_int_array_peek(g, start_offset, max_read, buf, 0, amt_read);
+}
+LOCAL void glas_int_array_push(glas* g, void const* data, size_t len, uint8_t width) {
+    assert(likely((NULL != data) || (0 == len)));
+    glas_api_enter(g);
+    glas_thread_stack_cell_push(g, glas_cell_int_array_alloc(data, len, width));
+    glas_api_exit(g);
+}
+API void glas_i64_array_push(glas* g, int64_t const* data, size_t len) {
+    glas_int_array_push(g, data, len, 3);
+}
+API void glas_i32_array_push(glas* g, int32_t const* data, size_t len) {
+    glas_int_array_push(g, data, len, 2);
+}
+API void glas_i16_array_push(glas* g, int16_t const* data, size_t len) {
+    glas_int_array_push(g, data, len, 1);
+}
+API void glas_i8_array_push(glas* g, int8_t const* data, size_t len) {
+    glas_int_array_push(g, data, len, 0);
+}
+
 LOCAL bool glas_unlr_ngc(glas* g, bool unr) {
-    (void)g; (void)unr;
-    debug("todo: pop bits");
-    abort();
+    glas_thread_stack_prep(g, 1, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc* const psc = s->data + s->count - 1;
+    glas_sc sc = *psc;
+    if(!glas_sc_bits_load(&sc) || (unr != (bool)(sc.stem >> 63))) {
+        return false; // stack unmodified
+    }
+    psc->stem = sc.stem << 1;
+    if(sc.cell != psc->cell) {
+        glas_stack_slot_write(&(g->state->gcbase), &(psc->cell), sc.cell);
+    }
+    return true;
 }
 
 API bool glas_unl(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     bool ok = glas_unlr_ngc(g, false);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 } 
 API bool glas_unr(glas* g) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     bool ok = glas_unlr_ngc(g, true);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 }
 
@@ -3363,145 +6292,653 @@ LOCAL glas_sc glas_data_i64(int64_t const n) {
     return sc;
 }
 API void glas_i64_push(glas* g, int64_t n) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_sc_push(g, glas_data_i64(n));
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 API void glas_i32_push(glas* g, int32_t n) { glas_i64_push(g, (int64_t) n); }
 API void glas_i16_push(glas* g, int16_t n) { glas_i64_push(g, (int64_t) n); }
 API void glas_i8_push(glas* g, int8_t n) { glas_i64_push(g, (int64_t) n); }
 API void glas_u64_push(glas* g, uint64_t n) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_sc_push(g, glas_data_u64(n));
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
 }
 API void glas_u32_push(glas* g, uint32_t n) { glas_u64_push(g, (uint64_t) n); }
 API void glas_u16_push(glas* g, uint16_t n) { glas_u64_push(g, (uint64_t) n); }
 API void glas_u8_push(glas* g, uint8_t n) { glas_u64_push(g, (uint64_t) n); }
 
-#if 0
-LOCAL bool glas_list_len_peek_cell(glas_cell* cell, size_t* aggrlen) {
-    do {
-        if(GLAS_DATA_IS_PTR(cell)) {
-            if(GLAS_STEM31_EMPTY != cell->stemHd) {
-                return false;
-            } 
-            switch(cell->hdr.type_id) {
-                case GLAS_TYPE_BRANCH:
-                    (*aggrlen)++;
-                    if(GLAS_STEM31_EMPTY != cell->branch.stemR) {
-                        return false;
-                    }
-                    cell = cell->branch.R;
-                    break;
-                case GLAS_TYPE_TAKE_CONCAT:
-                    (*aggrlen) += cell->take_concat.left_len;
-                    cell = cell->take_concat.right;
-                    break;
-                case GLAS_TYPE_BIG_ARR:
-                    (*aggrlen) += cell->big_arr.len;
-                    return true;
-                case GLAS_TYPE_BIG_BIN:
-                    (*aggrlen) += cell->big_bin.len;
-                    return true;
-                case GLAS_TYPE_SMALL_ARR:
-                case GLAS_TYPE_SMALL_BIN:
-                    (*aggrlen) += cell->hdr.type_arg;
-                    return true;
-                default:
-                    // TBD: force thunks or extrefs
-                    return false;
-            }
-        } else if(GLAS_VAL_UNIT == cell) {
+/**
+ * Batched primitive ops. We simulate stack depths up front to validate
+ * ops, detect underflow, and find how many items the batch reads and how
+ * much space it needs, then prepare the stack once. Individual ops still
+ * run their own prep checks, but these reduce to a predictable branch.
+ */
+typedef struct glas_op_effect {
+    uint16_t in, out;               // data stack
+    uint16_t stash_in, stash_out;   // stash
+} glas_op_effect;
+typedef struct glas_ops_plan {
+    size_t read;        // max items read below initial stack depth
+    size_t peak;        // max stack depth above initial depth
+    size_t stash_read;  // max items read below initial stash depth
+} glas_ops_plan;
+
+LOCAL bool glas_op_effect_of(glas_op const* op, glas_op_effect* e) {
+    (*e) = (glas_op_effect){ 0 };
+    switch(op->code) {
+        case GLAS_OP_MKP: e->in = 2; e->out = 1; return true;
+        case GLAS_OP_MKL:
+        case GLAS_OP_MKR:
+        case GLAS_OP_UNL:
+        case GLAS_OP_UNR: e->in = 1; e->out = 1; return true;
+        case GLAS_OP_UNP: e->in = 1; e->out = 2; return true;
+        case GLAS_OP_SWAP: e->in = 2; e->out = 2; return true;
+        case GLAS_OP_I64: e->out = 1; return true;
+        case GLAS_OP_COPY:
+            if((op->arg < 0) || (op->arg > UINT8_MAX)) { return false; }
+            e->in = (uint16_t) op->arg;
+            e->out = 2 * e->in;
             return true;
-        } else if(GLAS_DATA_IS_BINARY(cell)) {
-            // list of 1..7 bytes
-            (*aggrlen) += GLAS_DATA_BINARY_LEN(cell);
+        case GLAS_OP_DROP:
+            if((op->arg < 0) || (op->arg > UINT8_MAX)) { return false; }
+            e->in = (uint16_t) op->arg;
             return true;
-        } else if(GLAS_DATA_IS_SHRUB(cell)) {
-            // a shrub can encode a very small list
-            uint64_t shrub = GLAS_DATA_SHRUB_BITS(cell);
-            while(GLAS_SHRUB_IS_PAIR(shrub)) {
-                (*aggrlen)++;
-                shrub = glas_shrub_skip_elem(shrub << 2);
+        case GLAS_OP_STASH:
+            if((op->arg < INT8_MIN) || (op->arg > INT8_MAX)) { return false; }
+            if(op->arg >= 0) {
+                e->in = (uint16_t) op->arg;
+                e->stash_out = e->in;
+            } else {
+                e->stash_in = (uint16_t) (-(op->arg));
+                e->out = e->stash_in;
+            }
+            return true;
+        default: return false;
+    }
+}
+
+/**
+ * Returns index of first invalid op, or first op that would underflow
+ * given avail items on stack and stash, otherwise count. The plan covers
+ * the ops before the returned index.
+ */
+LOCAL size_t glas_ops_scan(glas_op const* ops, size_t count,
+    int64_t avail, int64_t stash_avail, glas_ops_plan* plan)
+{
+    int64_t depth = 0;
+    int64_t stash_depth = 0;
+    (*plan) = (glas_ops_plan){ 0 };
+    for(size_t ix = 0; ix < count; ++ix) {
+        glas_op_effect e;
+        if(!glas_op_effect_of(ops + ix, &e)) { return ix; }
+        int64_t const low = depth - (int64_t)e.in;
+        int64_t const stash_low = stash_depth - (int64_t)e.stash_in;
+        if(((-low) > avail) || ((-stash_low) > stash_avail)) { return ix; }
+        depth = low + (int64_t)e.out;
+        stash_depth = stash_low + (int64_t)e.stash_out;
+        if((-low) > (int64_t)plan->read) { plan->read = (size_t)(-low); }
+        if(depth > (int64_t)plan->peak) { plan->peak = (size_t)depth; }
+        if((-stash_low) > (int64_t)plan->stash_read) { plan->stash_read = (size_t)(-stash_low); }
+    }
+    return count;
+}
+
+LOCAL size_t glas_stack_avail(glas_stack const* s, size_t need) {
+    // count items on stack and overflow list, stopping at need.
+    size_t avail = s->count;
+    glas_cell const* iter = s->overflow;
+    while((avail < need) && (GLAS_VAL_UNIT != iter)) {
+        avail += glas_stack_chunk_len(iter);
+        iter = glas_stack_chunk_next(iter);
+    }
+    return avail;
+}
+
+API size_t glas_data_exec(glas* g, glas_op const* ops, size_t count) {
+    assert(likely((NULL != ops) || (0 == count)));
+    glas_api_enter(g);
+    glas_thread_state* const st = g->state;
+    glas_ops_plan plan;
+    size_t n = glas_ops_scan(ops, count, INT64_MAX, INT64_MAX, &plan);
+    bool underflow = false;
+    if((plan.read > st->stack.count) || (plan.stash_read > st->stash.count)) {
+        size_t const avail = glas_stack_avail(&(st->stack), plan.read);
+        size_t const stash_avail = glas_stack_avail(&(st->stash), plan.stash_read);
+        if((avail < plan.read) || (stash_avail < plan.stash_read)) {
+            size_t const k = glas_ops_scan(ops, n,
+                (int64_t)avail, (int64_t)stash_avail, &plan);
+            assert(likely(k < n));
+            n = k;
+            underflow = true;
+        }
+    }
+    if((plan.read + plan.peak) < GLAS_STACK_MAX) {
+        // the single precheck; otherwise ops shift overflow as needed
+        glas_thread_stack_prep(g, (uint8_t)plan.read, (uint8_t)plan.peak);
+    }
+    // Pairs are allocated in batches for each window of ops, so building a
+    // list costs one reservation per batch. Batch cells are uninitialized
+    // until their mkp runs, so we skip safepoints while any remain.
+    glas_cell* pairs[GLAS_CELL_BATCH_ALLOC];
+    size_t pairs_len = 0;
+    size_t pairs_used = 0;
+    size_t window_end = 0;
+    size_t amt_linear = 0;
+    size_t result = n;
+    for(size_t ix = 0; ix < n; ++ix) {
+        if(pairs_used == pairs_len) {
+            glas_os_thread_gc_safepoint();
+        }
+        if(ix == window_end) {
+            assert(likely(pairs_used == pairs_len));
+            window_end = ((n - ix) > GLAS_CELL_BATCH_ALLOC) ? (ix + GLAS_CELL_BATCH_ALLOC) : n;
+            size_t mkp_count = 0;
+            for(size_t k = ix; k < window_end; ++k) {
+                mkp_count += (GLAS_OP_MKP == ops[k].code) ? 1 : 0;
+            }
+            pairs_used = 0;
+            pairs_len = (mkp_count > 1) ? mkp_count : 0;
+            if(0 != pairs_len) {
+                glas_cell_alloc_batch(pairs, pairs_len);
             }
-            return GLAS_SHRUB_IS_UNIT(shrub);
+        }
+        glas_op const* const op = ops + ix;
+        bool ok = true;
+        switch(op->code) {
+            case GLAS_OP_MKP:
+                if(pairs_used < pairs_len) {
+                    glas_mkp_init_ngc(g, pairs[pairs_used++]);
+                } else {
+                    glas_mkp_ngc(g);
+                }
+                break;
+            case GLAS_OP_MKL: glas_mklr_ngc(g, false); break;
+            case GLAS_OP_MKR: glas_mklr_ngc(g, true); break;
+            case GLAS_OP_UNP: ok = glas_unp_ngc(g); break;
+            case GLAS_OP_UNL: ok = glas_unlr_ngc(g, false); break;
+            case GLAS_OP_UNR: ok = glas_unlr_ngc(g, true); break;
+            case GLAS_OP_COPY: amt_linear += glas_data_copy_lin_ngc(g, (uint8_t) op->arg); break;
+            case GLAS_OP_DROP: amt_linear += glas_data_drop_lin_ngc(g, (uint8_t) op->arg); break;
+            case GLAS_OP_SWAP: glas_data_swap_ngc(g); break;
+            case GLAS_OP_STASH: glas_data_stash_ngc(g, (int8_t) op->arg); break;
+            case GLAS_OP_I64: glas_thread_stack_sc_push(g, glas_data_i64(op->arg)); break;
+            default: assert(false); ok = false; break; // validated by scan
+        }
+        if(!ok) { result = ix; break; }
+    }
+    while(pairs_used < pairs_len) {
+        // batch cells left by a failed op become garbage pairs
+        static glas_sc const unit = { .stem = GLAS_STEM63_EMPTY, .cell = GLAS_VAL_UNIT };
+        glas_cell_pair_init_sc(pairs[pairs_used++], unit, unit);
+    }
+    glas_api_exit(g);
+    if(0 != amt_linear) {
+        g->err |= GLAS_E_LINEARITY;
+    }
+    if(underflow && (result == n)) {
+        g->err |= GLAS_E_UNDERFLOW;
+    }
+    return result;
+}
+
+/**
+ * Length queries. We don't walk the list or bitstring where a length is
+ * recorded: big binaries and arrays record len, rope nodes memoize the
+ * length of their left subtree in left_len, stem cells hold 32 bits per
+ * type_arg, and binary views record bit_len. Rope height bounds the
+ * right spine, and stem chain compaction bounds the chain, so length is
+ * O(1) for flat lists and O(log N) for ropes and bitstrings. Only a cons
+ * list is walked item by item.
+ */
+LOCAL bool glas_bits_len_cell(glas_cell* cell, uint64_t* len) {
+    // add bitstring length to len
+    uint64_t n = 0;
+    do {
+        if(GLAS_DATA_IS_BITS(cell)) {
+            n += 63 - ctz64(((uint64_t)cell) & ~UINT64_C(0b11));
+            (*len) += n;
+            return true;
+        } else if(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_STEM == cell->hdr.type_id)) {
+            n += (31 - ctz32(cell->stemHd)) + (32 * (uint64_t)cell->hdr.type_arg);
+            cell = cell->stem.fby;
+        } else if(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_STEM_OF_BIN == cell->hdr.type_id)) {
+            n += (31 - ctz32(cell->stemHd)) + (uint64_t)cell->stem_of_bin.bit_len;
+            cell = cell->stem_of_bin.fby;
         } else {
-            // not a list
+            // TBD: force thunks or extrefs
             return false;
         }
     } while(1);
 }
-LOCAL bool glas_list_len_peek_sc(glas_stemcell* sc, size_t* aggrlen) {
-    bool ok;
-    if(0 != (GLAS_STEMCELL_OPTVAL_FLAG & sc->stem)) {
-        // singleton list
-        (*aggrlen) += 1;
-        ok = true;
-    } else if(GLAS_STEMCELL_STEM_EMPTY != (GLAS_STEMCELL_STEMBITS & (sc->stem))) {
-        // not a list
-        ok = false; 
-    } else if(GLAS_DATA_IS_PTR(sc->cell)) {
-        glas_os_thread_enter_busy();
-        ok = glas_list_len_peek_cell(sc->cell, aggrlen);
-        glas_os_thread_exit_busy();
-    } else {
-        ok = glas_list_len_peek_cell(sc->cell, aggrlen);
+LOCAL inline bool glas_sc_bits_len(glas_sc sc, uint64_t* len) {
+    (*len) += 63 - ctz64(sc.stem);
+    return glas_bits_len_cell(sc.cell, len);
+}
+API void glas_list_len(glas* g) {
+    // L -- L N
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 1, 1);
+    glas_stack* const s = &(g->state->stack);
+    uint64_t len = 0;
+    bool const ok = glas_sc_list_len(s->data[s->count - 1], &len);
+    if(ok) {
+        glas_thread_stack_sc_push(g, glas_data_u64(len));
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_bits_len(glas* g) {
+    // B -- B N
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 1, 1);
+    glas_stack* const s = &(g->state->stack);
+    uint64_t len = 0;
+    bool const ok = glas_sc_bits_len(s->data[s->count - 1], &len);
+    if(ok) {
+        glas_thread_stack_sc_push(g, glas_data_u64(len));
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
     }
-    return ok;
 }
 
-LOCAL bool glas_bits_len_peek_cell(glas_cell* cell, size_t* aggrlen) {
-    do {
-        if(GLAS_DATA_IS_BITS(cell)) {
-            (*aggrlen) += 63 - ctz64(((uint64_t)cell) & ~((uint64_t)0b11));
-            return true;
-        } else if(GLAS_DATA_IS_PTR(cell)) {
-            (*aggrlen) += 31 - ctz32(cell->stemHd);
-            if(GLAS_TYPE_STEM == cell->hdr.type_id) {
-                (*aggrlen) += 32 * cell->hdr.type_arg;
-                cell = cell->stem.fby;
+/**
+ * Bitstring split, append, and binary conversions. Binaries of at least
+ * GLAS_STEM_OF_BIN_MIN bytes convert to stem of binary views, so of_bin
+ * is O(1) per rope leaf. Where views are byte-aligned, to_bin returns to
+ * slices of the same binary. Split and append are O(1) within a view,
+ * otherwise they rebuild the stem cells of the left bitstring.
+ */
+LOCAL bool glas_list_read_bytes(glas_cell* cell, uint64_t len, uint8_t* dst) {
+    // read len bytes from a list, false if an item isn't a byte
+    uint64_t ix = 0;
+    while(ix < len) {
+        uint64_t offset = ix;
+        uint64_t avail = len - ix;
+        glas_cell* leaf = glas_rope_leaf_at(cell, &offset, &avail);
+        uint8_t tmp[8];
+        uint8_t const* data;
+        if(glas_list_leaf_bytes(leaf, &data, tmp)) {
+            memcpy(dst + ix, data + offset, avail);
+            ix += avail;
+        } else if(glas_rope_leaf_is_flat(leaf)) {
+            int64_t ints[64];
+            size_t const amt = (avail > 64) ? 64 : (size_t) avail;
+            if(amt != glas_rope_leaf_read_i64(&leaf, offset, amt, ints)) { return false; }
+            for(size_t k = 0; k < amt; ++k) {
+                if((ints[k] < 0) || (ints[k] > UINT8_MAX)) { return false; }
+                dst[ix++] = (uint8_t) ints[k];
+            }
+        } else {
+            // cons list, walked once
+            glas_sc hd, tl;
+            for(uint64_t k = 0; k < offset; ++k) {
+                glas_cell_split_pair(leaf, &hd, &tl);
+                leaf = tl.cell;
+            }
+            for(uint64_t k = 0; k < avail; ++k) {
+                uint64_t n = 0;
+                glas_cell_split_pair(leaf, &hd, &tl);
+                if(!glas_u64_peek_sc(&hd, &n) || (n > UINT8_MAX)) { return false; }
+                dst[ix++] = (uint8_t) n;
+                leaf = tl.cell;
+            }
+        }
+    }
+    return true;
+}
+LOCAL bool glas_bits_prepend_bin(glas_cell* cell, uint64_t len, glas_sc* sc) {
+    // prepend bits of a binary onto sc, false if not a binary
+    if(0 == len) { return true; }
+    if(0 < glas_rope_height(cell)) {
+        uint64_t const left_len = cell->take_concat.left_len;
+        return glas_bits_prepend_bin(cell->take_concat.right, len - left_len, sc) &&
+               glas_bits_prepend_bin(cell->take_concat.left, left_len, sc);
+    }
+    if(GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_BIG_BIN == cell->hdr.type_id) &&
+       (GLAS_STEM_OF_BIN_MIN <= len))
+    {
+        // view the binary, chaining views for the very large
+        static uint64_t const chunk = GLAS_STEM_OF_BIN_MAX / 8;
+        uint64_t end = len;
+        do {
+            uint64_t const start = (end > chunk) ? (end - chunk) : 0;
+            glas_cell* const bin = ((0 == start) && (end == len)) ? cell :
+                glas_cell_binary_slice(cell->big_bin.data + start, end - start, cell->big_bin.fptr);
+            sc->cell = glas_cell_stem_of_bin_alloc(bin, 0, 8 * (end - start), glas_sc_to_cell(*sc));
+            sc->stem = GLAS_STEM63_EMPTY;
+            end = start;
+        } while(end > 0);
+        return true;
+    }
+    uint8_t local[GLAS_ROPE_LEAF_BYTES];
+    uint8_t* const buf = (len > sizeof(local)) ? malloc(len) : local;
+    bool const ok = glas_list_read_bytes(cell, len, buf);
+    if(ok && (GLAS_STEM_OF_BIN_MIN <= len)) {
+        // flatten, e.g. an array of bytes, then view it
+        glas_bits_prepend_bin(glas_cell_binary_alloc(buf, len), len, sc);
+    } else if(ok) {
+        for(uint64_t ix = len; ix > 0; --ix) {
+            glas_byte_sc_push(buf[ix - 1], sc);
+        }
+    }
+    if(buf != local) { free(buf); }
+    return ok;
+}
+LOCAL void glas_bits_prepend_view(glas_cell* binary, uint64_t pos, uint64_t len, glas_sc* sc) {
+    // prepend bits of binary from pos, as a view only if long enough
+    if((8 * GLAS_STEM_OF_BIN_MIN) <= len) {
+        sc->cell = glas_cell_stem_of_bin_alloc(binary, pos, len, glas_sc_to_cell(*sc));
+        sc->stem = GLAS_STEM63_EMPTY;
+        return;
+    }
+    while(len > 0) {
+        size_t const k = (len > 56) ? 56 : (size_t) len;
+        uint64_t const bits = glas_bin_bits_read(binary, pos + len - k, k);
+        glas_stem_sc_push(((bits<<1)|1)<<(63-k), sc);
+        len -= k;
+    }
+}
+LOCAL glas_sc glas_bits_join(glas_sc l, glas_sc r) {
+    // assumes l is a bitstring. We rebuild the cells of l with r in place
+    // of its final unit. Adjacent views of one binary are rejoined.
+    glas_cell* local[16];
+    glas_cell** spine = local;
+    size_t count = 0;
+    size_t cap = 16;
+    glas_cell* cell = l.cell;
+    while(GLAS_DATA_IS_PTR(cell)) {
+        if(count == cap) {
+            cap *= 2;
+            spine = (spine == local) ? memcpy(malloc(cap * sizeof(glas_cell*)), local, sizeof(local)) :
+                                       realloc(spine, cap * sizeof(glas_cell*));
+        }
+        spine[count++] = cell;
+        cell = (GLAS_TYPE_STEM == cell->hdr.type_id) ? cell->stem.fby : cell->stem_of_bin.fby;
+    }
+    assert(likely(GLAS_DATA_IS_BITS(cell)));
+    glas_sc acc = r;
+    glas_stem_sc_push(((uint64_t)cell) & ~UINT64_C(0b11), &acc);
+    while(count > 0) {
+        glas_cell* const c = spine[--count];
+        glas_cell* const fby = glas_sc_to_cell(acc);
+        glas_cell* joined;
+        if((GLAS_TYPE_STEM_OF_BIN == c->hdr.type_id) && glas_cell_is_stem_of_bin(fby) &&
+           (c->stem_of_bin.binary == fby->stem_of_bin.binary) &&
+           ((c->stem_of_bin.bit_offset + (uint64_t)c->stem_of_bin.bit_len) == fby->stem_of_bin.bit_offset))
+        {
+            joined = glas_cell_stem_of_bin_alloc(c->stem_of_bin.binary, c->stem_of_bin.bit_offset,
+                (uint64_t)c->stem_of_bin.bit_len + fby->stem_of_bin.bit_len, fby->stem_of_bin.fby);
+            joined->stemHd = c->stemHd;
+        } else {
+            joined = glas_cell_clone(c);
+            joined->hdr.type_aggr = glas_cell_type_aggr(fby);
+            if(GLAS_TYPE_STEM == c->hdr.type_id) {
+                joined->stem.fby = fby;
             } else {
-                // TBD: force thunks or extrefs
-                // might add stem-of-bin eventually
-                return false;
+                joined->stem_of_bin.fby = fby;
             }
-        } else if(GLAS_DATA_IS_SHRUB(cell)) {
-            // squeeze out a few more edge bits
-            uint64_t shrub = GLAS_DATA_SHRUB_BITS(cell);
-            while(GLAS_SHRUB_IS_EDGE(shrub)) {
-                shrub = (shrub << 2);
-                (*aggrlen)++;
+        }
+        acc.stem = GLAS_STEM63_EMPTY;
+        acc.cell = joined;
+    }
+    if(spine != local) { free(spine); }
+    glas_stem_sc_push(l.stem, &acc);
+    return acc;
+}
+typedef struct glas_bits_piece {
+    glas_cell* binary;  // view of binary, or NULL for stem bits
+    uint64_t stem;      // stem bits, or bit offset into binary
+    uint64_t len;
+} glas_bits_piece;
+LOCAL void glas_bits_split_sc(glas_sc b, uint64_t at, glas_sc* outl, glas_sc* outr) {
+    // assumes b is a bitstring of at least `at` bits. We take pieces from
+    // the head of b, then build the left bitstring in reverse.
+    glas_bits_piece local[16];
+    glas_bits_piece* pieces = local;
+    size_t count = 0;
+    size_t cap = 16;
+    while(at > 0) {
+        if(count == cap) {
+            cap *= 2;
+            pieces = (pieces == local) ? memcpy(malloc(cap * sizeof(glas_bits_piece)), local, sizeof(local)) :
+                                         realloc(pieces, cap * sizeof(glas_bits_piece));
+        }
+        if(GLAS_STEM63_EMPTY == b.stem) {
+            glas_cell* const c = b.cell;
+            if(glas_cell_is_stem_of_bin(c)) {
+                uint64_t const len = c->stem_of_bin.bit_len;
+                uint64_t const take = (at < len) ? at : len;
+                pieces[count++] = (glas_bits_piece){ .binary = c->stem_of_bin.binary,
+                    .stem = c->stem_of_bin.bit_offset, .len = take };
+                b.cell = (take == len) ? c->stem_of_bin.fby :
+                    glas_cell_stem_of_bin_alloc(c->stem_of_bin.binary,
+                        c->stem_of_bin.bit_offset + take, len - take, c->stem_of_bin.fby);
+                at -= take;
+                continue;
             }
-            assert(GLAS_SHRUB_IS_PAIR(shrub) && "shrub must contain pair");
-            return false; 
-        } else if(GLAS_DATA_IS_PACKRAT(cell)) {
-            // rationals share 4 bits between 'n:' and 'd:' dict keys.
-            //  'n' 0x6E 0b01101110
-            //  'd' 0x64 0b01100100
-            (*aggrlen) += 4;
-            return false;
+            b.stem = glas_cell_stem_pop(&(b.cell));
+            assert(likely(GLAS_STEM63_EMPTY != b.stem));
+        }
+        size_t const avail = 63 - ctz64(b.stem);
+        if(at >= avail) {
+            pieces[count++] = (glas_bits_piece){ .binary = NULL, .stem = b.stem, .len = avail };
+            b.stem = GLAS_STEM63_EMPTY;
+            at -= avail;
         } else {
-            return false;
+            uint64_t const head = (((b.stem >> (64 - at)) << 1) | 1) << (63 - at);
+            pieces[count++] = (glas_bits_piece){ .binary = NULL, .stem = head, .len = at };
+            b.stem = b.stem << at;
+            at = 0;
         }
-    } while(1);
+    }
+    glas_sc l = { .stem = GLAS_STEM63_EMPTY, .cell = GLAS_VAL_UNIT };
+    while(count > 0) {
+        glas_bits_piece const p = pieces[--count];
+        if(NULL == p.binary) {
+            glas_stem_sc_push(p.stem, &l);
+        } else {
+            glas_bits_prepend_view(p.binary, p.stem, p.len, &l);
+        }
+    }
+    if(pieces != local) { free(pieces); }
+    (*outl) = l;
+    (*outr) = b;
 }
-LOCAL bool glas_bits_len_peek_sc(glas_stemcell* sc, size_t* aggrlen) {
-    if(0 != (GLAS_STEMCELL_OPTVAL_FLAG & sc->stem)) {
-        return false;
+/**
+ * Binary writer. Unaligned bits are written in place into a segment, a
+ * binary of at most GLAS_BIN_WRITER_SEGMENT bytes, which is joined onto
+ * the output rope when full or before appending a shared binary. Thus
+ * we never buffer the whole output, and bytes are written only once.
+ * Segments start small and double, so a short run isn't given 64kB.
+ */
+#define GLAS_BIN_WRITER_SEGMENT (64 * 1024)
+typedef struct glas_bin_writer {
+    glas_cell* out;     // rope of binaries written so far
+    uint64_t out_len;
+    uint64_t remaining; // bytes not yet allocated to out or segment
+    glas_cell* seg;     // segment binary, NULL if small or none
+    uint8_t* data;      // segment data, or small
+    size_t cap, pos;    // bytes in segment
+    size_t grow;        // capacity of next segment
+    uint64_t acc;       // pending bits, fewer than 8
+    size_t acc_len;
+    uint8_t small[24];  // short segments are copied to a small binary
+} glas_bin_writer;
+LOCAL void glas_bin_writer_flush(glas_bin_writer* w) {
+    // join the segment onto out, returning unused capacity
+    if(0 == w->cap) { return; }
+    glas_cell* seg = w->seg;
+    if((NULL == seg) || (24 >= w->pos)) {
+        seg = glas_cell_binary_alloc(w->data, w->pos);
+    } else if(w->pos < w->cap) {
+        seg->big_bin.len = w->pos; // not yet shared, safe to shrink
     }
-    (*aggrlen) += ctz64(GLAS_STEMCELL_STEMBITS & sc->stem) - 3;
-    bool ok;
-    if(GLAS_DATA_IS_PTR(sc->cell)) {
-        glas_os_thread_enter_busy();
-        ok = glas_bits_len_peek_cell(sc->cell, aggrlen);
-        glas_os_thread_exit_busy();
+    w->out = glas_rope_join(w->out, w->out_len, seg, w->pos);
+    w->out_len += w->pos;
+    w->remaining += w->cap - w->pos;
+    w->seg = NULL;
+    w->data = NULL;
+    w->cap = 0;
+    w->pos = 0;
+}
+LOCAL void glas_bin_writer_segment(glas_bin_writer* w) {
+    // start a new segment, sized to what remains of the output
+    glas_bin_writer_flush(w);
+    assert(likely(0 < w->remaining));
+    size_t const want = (sizeof(w->small) > w->grow) ? sizeof(w->small) : w->grow;
+    w->cap = (w->remaining > want) ? want : (size_t) w->remaining;
+    w->remaining -= w->cap;
+    w->grow = ((2 * w->cap) > GLAS_BIN_WRITER_SEGMENT) ? GLAS_BIN_WRITER_SEGMENT : (2 * w->cap);
+    if(sizeof(w->small) >= w->cap) {
+        w->data = w->small;
     } else {
-        ok = glas_bits_len_peek_cell(sc->cell, aggrlen);
+        w->seg = glas_cell_binary_alloc_uninit(w->cap, &(w->data));
+    }
+}
+LOCAL void glas_bin_writer_bits(glas_bin_writer* w, uint64_t bits, size_t len) {
+    // write the low len bits (up to 64), msb first
+    while(len > 0) {
+        size_t const take = (len > 32) ? 32 : len;
+        w->acc = (w->acc << take) | ((bits >> (len - take)) & ((UINT64_C(1) << take) - 1));
+        w->acc_len += take;
+        len -= take;
+        while(w->acc_len >= 8) {
+            if(w->pos == w->cap) { glas_bin_writer_segment(w); }
+            w->acc_len -= 8;
+            w->data[(w->pos)++] = (uint8_t)(w->acc >> w->acc_len);
+        }
+    }
+}
+LOCAL void glas_bin_writer_append(glas_bin_writer* w, glas_cell* bin, uint64_t len) {
+    // flush the segment, then append a binary of len bytes
+    glas_bin_writer_flush(w);
+    assert(likely(len <= w->remaining));
+    w->grow = 0;
+    w->out = glas_rope_join(w->out, w->out_len, bin, len);
+    w->out_len += len;
+    w->remaining -= len;
+}
+LOCAL glas_cell* glas_bits_to_bin_cell(glas_sc b, uint64_t nbytes) {
+    // assumes b is a bitstring of 8 * nbytes bits
+    glas_bin_writer w = { .out = GLAS_VAL_UNIT, .remaining = nbytes };
+    do {
+        if(GLAS_STEM63_EMPTY == b.stem) {
+            glas_cell* const c = b.cell;
+            if(glas_cell_is_stem_of_bin(c)) {
+                glas_cell* const bin = c->stem_of_bin.binary;
+                uint64_t const pos = c->stem_of_bin.bit_offset;
+                uint64_t const len = c->stem_of_bin.bit_len;
+                if((0 == w.acc_len) && (0 == ((pos | len) % 8)) && ((8 * GLAS_STEM_OF_BIN_MIN) <= len)) {
+                    // byte-aligned, share the binary
+                    uint64_t const n = len / 8;
+                    glas_bin_writer_append(&w,
+                        ((0 == pos) && (n == bin->big_bin.len)) ? bin :
+                            glas_cell_binary_slice(bin->big_bin.data + (pos / 8), n, bin->big_bin.fptr),
+                        n);
+                } else {
+                    for(uint64_t at = 0; at < len; at += 56) {
+                        size_t const k = ((len - at) > 56) ? 56 : (size_t)(len - at);
+                        glas_bin_writer_bits(&w, glas_bin_bits_read(bin, pos + at, k), k);
+                    }
+                }
+                b.cell = c->stem_of_bin.fby;
+                continue;
+            }
+            b.stem = glas_cell_stem_pop(&(b.cell));
+            if(GLAS_STEM63_EMPTY == b.stem) { break; }
+        }
+        size_t const shift = 1 + ctz64(b.stem);
+        glas_bin_writer_bits(&w, b.stem >> shift, 64 - shift);
+        b.stem = GLAS_STEM63_EMPTY;
+    } while(1);
+    glas_bin_writer_flush(&w);
+    assert(likely((GLAS_VAL_UNIT == b.cell) && (0 == w.acc_len) && 
+                  (0 == w.remaining) && (nbytes == w.out_len)));
+    return w.out;
+}
+API void glas_bits_split(glas* g) {
+    // (B1++B2) N -- B1 B2
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 2, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const b = s->data[s->count - 2];
+    glas_sc n = s->data[s->count - 1];
+    uint64_t len = 0, at = 0;
+    bool const ok = glas_sc_bits_len(b, &len) && glas_u64_peek_sc(&n, &at) && (at <= len);
+    if(ok) {
+        glas_sc l, r;
+        glas_bits_split_sc(b, at, &l, &r);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_push(g, l);
+        glas_thread_stack_sc_push(g, r);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_bits_append(glas* g) {
+    // B1 B2 -- (B1++B2)
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 2, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const l = s->data[s->count - 2];
+    glas_sc const r = s->data[s->count - 1];
+    uint64_t llen = 0, rlen = 0;
+    bool const ok = glas_sc_bits_len(l, &llen) && glas_sc_bits_len(r, &rlen);
+    if(ok) {
+        glas_sc const lr = glas_bits_join(l, r);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_push(g, lr);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_bits_of_bin(glas* g) {
+    // Binary -- Bitstring
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 1, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const bin = s->data[s->count - 1];
+    glas_sc bits = { .stem = GLAS_STEM63_EMPTY, .cell = GLAS_VAL_UNIT };
+    uint64_t len = 0;
+    bool const ok = glas_sc_list_len(bin, &len) && glas_bits_prepend_bin(bin.cell, len, &bits);
+    if(ok) {
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_sc_push(g, bits);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
+    }
+}
+API void glas_bits_to_bin(glas* g) {
+    // Bitstring -- Binary
+    glas_api_enter(g);
+    glas_thread_stack_prep(g, 1, 0);
+    glas_stack* const s = &(g->state->stack);
+    glas_sc const bits = s->data[s->count - 1];
+    uint64_t len = 0;
+    bool const ok = glas_sc_bits_len(bits, &len) && (0 == (len % 8));
+    if(ok) {
+        glas_cell* const bin = glas_bits_to_bin_cell(bits, len / 8);
+        glas_thread_stack_sc_pop(g);
+        glas_thread_stack_cell_push(g, bin);
+    }
+    glas_api_exit(g);
+    if(!ok) {
+        g->err |= GLAS_E_TYPE;
     }
-    return ok;
 }
-#endif
 LOCAL inline uint64_t glas_sc_stembits_pop(glas_sc* sc) {
     uint64_t const stem = sc->stem;
     sc->stem = GLAS_STEM63_EMPTY;
@@ -3517,7 +6954,9 @@ LOCAL inline bool glas_sc_stembits_pop64(glas_sc* sc, uint64_t* bits, size_t* le
         if((*len) > shift) { 
             return false; // overflow
         }
-        (*bits) = ((*bits) << stemlen) | (stem >> shift);
+        if(0 < stemlen) { // avoid shift by 64 for an empty stem
+            (*bits) = ((*bits) << stemlen) | (stem >> shift);
+        }
         (*len) += stemlen;
     } while(glas_sc_bits_load(sc));
     return (GLAS_VAL_UNIT == sc->cell); // fully read bitstring
@@ -3565,11 +7004,11 @@ LOCAL bool glas_i64_peek_sc(glas_sc* osc, int64_t* n) {
     return false;
 }
 API bool glas_i64_peek(glas* g, int64_t* n) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_prep(g, 1, 0);
     glas_stack* const s = &(g->state->stack);
     bool const ok = glas_i64_peek_sc((s->data + s->count - 1), n);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 }
 API bool glas_i32_peek(glas* g, int32_t* n) {
@@ -3592,11 +7031,11 @@ API bool glas_i8_peek(glas* g, int8_t* n) {
 }
 
 API bool glas_u64_peek(glas* g, uint64_t* n) {
-    glas_os_thread_enter_busy();
+    glas_api_enter(g);
     glas_thread_stack_prep(g, 1, 0);
     glas_stack* const s = &(g->state->stack);
     bool const ok = glas_u64_peek_sc((s->data + s->count - 1), n);
-    glas_os_thread_exit_busy();
+    glas_api_exit(g);
     return ok;
 }
 API bool glas_u32_peek(glas* g, uint32_t* n) {
@@ -3637,6 +7076,42 @@ LOCAL void test_teardown() {
     glas_rt_tls_reset();
     memset(&test, 0, sizeof(struct test_state));
 }
+LOCAL bool test_wait(struct timespec* start, size_t step_usec, size_t max_msec) {
+    // pause in a polling loop; false once ~max_msec have passed since the
+    // first call (zero `start` before it). A zero step just yields, for
+    // loops that do their own work between polls.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if((0 == start->tv_sec) && (0 == start->tv_nsec)) { *start = now; }
+    int64_t const elapsed_msec = ((int64_t)(now.tv_sec - start->tv_sec) * 1000) +
+                                 ((int64_t)(now.tv_nsec - start->tv_nsec) / 1000000);
+    if(elapsed_msec >= (int64_t)max_msec) { return false; }
+    if(0 == step_usec) {
+        sched_yield();
+    } else {
+        struct timespec tm = { .tv_sec = 0, .tv_nsec = 1000 * (long)step_usec };
+        nanosleep(&tm, NULL);
+    }
+    return true;
+}
+LOCAL bool test_gc_wait_cycles(glas_gc_flags flags, uint64_t count) {
+    // wait for at least `count` GC cycles to complete, up to ~10sec
+    uint64_t const goal = count + 1 + atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    struct timespec start = { 0 };
+    do {
+        if(goal <= atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire)) { return true; }
+        glas_rt_gc_trigger(flags);
+    } while(test_wait(&start, 1000, 10000));
+    return false;
+}
+LOCAL bool test_wait_until(_Atomic(size_t)* count, size_t goal) {
+    // wait up to ~1sec for background work (e.g. decref) to reach goal
+    struct timespec start = { 0 };
+    do {
+        if(goal == atomic_load_explicit(count, memory_order_relaxed)) { return true; }
+    } while(test_wait(&start, 1000, 1000));
+    return false;
+}
 MU_TEST(test_bitmanip) {
     mu_assert_int_eq(21, (int) popcount64(UINT64_C(0x707070707077)));
     mu_assert_int_eq(14, (int) popcount64(UINT64_C(0x09606606609)));
@@ -3726,6 +7201,54 @@ MU_TEST(test_big_bits) {
     mu_assert((GLAS_STEM63_EMPTY == sc.stem) && (GLAS_VAL_UNIT == sc.cell), "all bits popped");
     mu_assert_int_eq(0, (int)unmatched);
 }
+MU_TEST(test_stack_spill) {
+    // push enough data to spill the stack to overflow, then read it back
+    static size_t const count = 1000;
+    for(size_t ix = 0; ix < count; ++ix) {
+        glas_i64_push(test.g, (int64_t)(ix * 1000003));
+    }
+    size_t mismatch = 0;
+    for(size_t ix = count; ix > 0; --ix) {
+        int64_t n = 0;
+        glas_i64_peek(test.g, &n);
+        mismatch += (n == (int64_t)((ix - 1) * 1000003)) ? 0 : 1;
+        glas_data_drop(test.g, 1);
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+}
+MU_TEST(test_stack_chunks) {
+    // spill in chunks, including stem bits; refill in chunks or partial
+    glas* const g = test.g;
+    static size_t const count = 500;
+    for(size_t ix = 0; ix < count; ++ix) {
+        // alternate small ints and ints with overflow into stem bits
+        int64_t const n = (ix & 1) ? (INT64_MAX - (int64_t)ix) : (1 + (int64_t)ix);
+        glas_i64_push(g, n);
+    }
+    size_t chunks = 0;
+    size_t items = g->state->stack.count;
+    for(glas_cell* c = g->state->stack.overflow; GLAS_VAL_UNIT != c; c = glas_stack_chunk_next(c)) {
+        ++chunks;
+        items += glas_stack_chunk_len(c);
+    }
+    mu_assert_int_eq((int)count, (int)items);
+    mu_assert(chunks < (count / 8), "spilled in chunks");
+    size_t mismatch = 0;
+    for(size_t ix = count; ix > 0; ) {
+        // large reads force refills that may split chunks
+        glas_data_move(g, "abcdefghijklmnopqrstuvwxyz-abcdefghijklmnopqrstuvwxyz");
+        size_t const amt = (ix > 3) ? 3 : ix;
+        for(size_t jx = 0; jx < amt; ++jx) {
+            --ix;
+            int64_t const expect = (ix & 1) ? (INT64_MAX - (int64_t)ix) : (1 + (int64_t)ix);
+            int64_t n = -1;
+            mismatch += (glas_i64_peek(g, &n) && (n == expect)) ? 0 : 1;
+            glas_data_drop(g, 1);
+        }
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    mu_assert(0 != (g->err & GLAS_E_UNDERFLOW), "final moves underflow");
+}
 void test_fin_refct_upd(void* arg, bool incref) {
     _Atomic(size_t)* const count = arg;
     if(incref) {
@@ -3734,6 +7257,532 @@ void test_fin_refct_upd(void* arg, bool incref) {
         atomic_fetch_sub_explicit(count, 1, memory_order_relaxed);
     }
 }
+MU_TEST(test_thread_state_pool) {
+    // after warmup, step abort and commit recycle thread states
+    glas_i64_push(test.g, 7);
+    mu_check(glas_step_commit(test.g));
+    uint64_t const alloc_start = atomic_load_explicit(&glas_rt.stat.g_ts_alloc, memory_order_relaxed);
+    uint64_t const reuse_start = atomic_load_explicit(&glas_rt.stat.g_ts_reuse, memory_order_relaxed);
+    static size_t const count = 1000;
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < count; ++ix) {
+        glas_i64_push(test.g, (int64_t)ix);
+        if(0 == (ix % 250)) {
+            mu_check(glas_step_commit(test.g));
+            glas_data_drop(test.g, 1);
+            mu_check(glas_step_commit(test.g));
+        } else {
+            glas_step_abort(test.g);
+        }
+        int64_t n = 0;
+        glas_i64_peek(test.g, &n);
+        mismatch += (7 == n) ? 0 : 1;
+    }
+    uint64_t const alloc_end = atomic_load_explicit(&glas_rt.stat.g_ts_alloc, memory_order_relaxed);
+    uint64_t const reuse_end = atomic_load_explicit(&glas_rt.stat.g_ts_reuse, memory_order_relaxed);
+    mu_assert_int_eq(0, (int) mismatch);
+    mu_assert_int_eq(0, (int)(alloc_end - alloc_start));
+    mu_check(count <= (reuse_end - reuse_start));
+    glas_data_drop(test.g, 1);
+}
+MU_TEST(test_api_session) {
+    // sessions hold the OS thread busy across API calls, yet GC cycles
+    // still complete via safepoints within API ops
+    glas_session_begin(test.g);
+    glas_session_begin(test.g); // nested
+    bool const busy = glas_os_thread_is_busy();
+    uint64_t const goal = 2 + atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    glas_rt_gc_trigger(GLAS_GC_MINOR);
+    struct timespec start = { 0 };
+    for(size_t ix = 0; ; ++ix) {
+        glas_i64_push(test.g, (int64_t)ix);
+        glas_i64_push(test.g, 1);
+        glas_mkp(test.g);
+        glas_data_drop(test.g, 1);
+        if(goal <= atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire)) { break; }
+        if((0 == (ix % 1024)) && !test_wait(&start, 0, 2000)) { break; }
+    }
+    bool const cycled = (goal <= atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire));
+    glas_session_end(test.g);
+    bool const still_busy = glas_os_thread_is_busy();
+    glas_session_end(test.g);
+    mu_assert(busy && still_busy, "busy within session");
+    mu_assert(!glas_os_thread_is_busy(), "idle after session");
+    mu_assert(cycled, "GC cycle within session");
+}
+MU_TEST(test_data_exec) {
+    glas* const g = test.g;
+    int64_t n = -1;
+    // underflow reports the op, applies prior ops
+    glas_op const under[] = { { GLAS_OP_I64, 1 }, { GLAS_OP_DROP, 2 } };
+    mu_assert_int_eq(1, (int) glas_data_exec(g, under, 2));
+    mu_assert(0 != (g->err & GLAS_E_UNDERFLOW), "underflow error");
+    g->err = 0;
+    mu_assert(glas_i64_peek(g, &n) && (1 == n), "ops before underflow applied");
+
+    glas_op const ops[] = {
+        { GLAS_OP_DROP, 1 },
+        { GLAS_OP_I64, 42 }, { GLAS_OP_MKL, 0 }, { GLAS_OP_MKR, 0 },
+        { GLAS_OP_UNR, 0 }, { GLAS_OP_UNL, 0 },             // 42
+        { GLAS_OP_I64, -7 }, { GLAS_OP_SWAP, 0 },           // -7 42
+        { GLAS_OP_COPY, 2 }, { GLAS_OP_DROP, 1 },           // -7 42 -7
+        { GLAS_OP_STASH, 2 }, { GLAS_OP_STASH, -1 },        // -7 42 | -7
+        { GLAS_OP_MKP, 0 }, { GLAS_OP_STASH, -1 },          // (-7,42) -7
+    };
+    size_t const ops_count = sizeof(ops)/sizeof(ops[0]);
+    mu_assert_int_eq((int)ops_count, (int) glas_data_exec(g, ops, ops_count));
+    mu_assert(glas_i64_peek(g, &n) && (-7 == n), "exec result");
+    mu_assert(0 == g->err, "no errors");
+
+    // unl/unr on integer bits: 5 is 0b101
+    glas_op const bits[] = {
+        { GLAS_OP_DROP, 1 }, { GLAS_OP_I64, 5 },
+        { GLAS_OP_UNR, 0 }, { GLAS_OP_UNL, 0 }, { GLAS_OP_UNR, 0 },
+        { GLAS_OP_UNL, 0 }, // fails on unit
+        { GLAS_OP_MKL, 0 },
+    };
+    mu_assert_int_eq(5, (int) glas_data_exec(g, bits, 7));
+    glas_sc const top = g->state->stack.data[g->state->stack.count - 1];
+    mu_assert((GLAS_STEM63_EMPTY == top.stem) && (GLAS_VAL_UNIT == top.cell), "bits consumed");
+
+    // invalid ops are reported before anything runs after them
+    glas_op const bad[] = { { GLAS_OP_DROP, 1 }, { GLAS_OP_COPY, 300 }, { GLAS_OP_I64, 1 } };
+    mu_assert_int_eq(1, (int) glas_data_exec(g, bad, 3));
+    glas_op const bad_code[] = { { GLAS_OP_I64, 1 }, { (glas_opcode)0, 0 } };
+    mu_assert_int_eq(1, (int) glas_data_exec(g, bad_code, 2));
+    mu_assert(0 == g->err, "no errors on invalid ops");
+
+    // deep batches bypass the precheck and spill to overflow
+    glas_op deep[2 * GLAS_STACK_MAX + 1];
+    for(size_t ix = 0; ix < 2 * GLAS_STACK_MAX; ++ix) {
+        deep[ix] = (glas_op){ GLAS_OP_I64, 1 + (int64_t) ix };
+    }
+    deep[2 * GLAS_STACK_MAX] = (glas_op){ GLAS_OP_DROP, 2 * GLAS_STACK_MAX - 1 };
+    mu_assert_int_eq(2 * GLAS_STACK_MAX + 1, (int) glas_data_exec(g, deep, 2 * GLAS_STACK_MAX + 1));
+    mu_assert(glas_i64_peek(g, &n) && (1 == n), "deep batch");
+    glas_data_drop(g, 3);
+    mu_assert(0 == g->err, "no errors on deep batch");
+
+    // list building spans several batches of pair cells
+    static size_t const list_len = 1000;
+    glas_op* const build = malloc((1 + 3 * list_len) * sizeof(glas_op));
+    build[0] = (glas_op){ GLAS_OP_I64, 0 }; // unit
+    for(size_t ix = 0; ix < list_len; ++ix) {
+        build[1 + 3 * ix] = (glas_op){ GLAS_OP_I64, (int64_t)(list_len - ix) };
+        build[2 + 3 * ix] = (glas_op){ GLAS_OP_SWAP, 0 };
+        build[3 + 3 * ix] = (glas_op){ GLAS_OP_MKP, 0 };
+    }
+    mu_assert_int_eq((int)(1 + 3 * list_len), (int) glas_data_exec(g, build, 1 + 3 * list_len));
+    free(build);
+    int64_t items[1000];
+    size_t amt = 0;
+    mu_assert(glas_i64_array_peek(g, 0, list_len, items, &amt) && (list_len == amt), "built list");
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < list_len; ++ix) {
+        mismatch += (items[ix] == (int64_t)(1 + ix)) ? 0 : 1;
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    glas_data_drop(g, 1);
+
+    // a failed op leaves batch cells for later mkp ops unused
+    glas_op const fail[] = {
+        { GLAS_OP_I64, 0 }, { GLAS_OP_I64, 1 }, { GLAS_OP_MKP, 0 },
+        { GLAS_OP_I64, 5 }, { GLAS_OP_UNP, 0 }, { GLAS_OP_MKP, 0 }, { GLAS_OP_MKP, 0 },
+    };
+    mu_assert_int_eq(4, (int) glas_data_exec(g, fail, 7));
+    glas_data_drop(g, 2);
+    mu_assert(0 == g->err, "no errors on list building");
+}
+MU_TEST(test_data_move) {
+    glas* const g = test.g;
+    glas_moves plan;
+    mu_assert(!glas_moves_compile(&plan, "ab"), "missing separator");
+    mu_assert(!glas_moves_compile(&plan, "aa-a"), "reused var");
+    mu_assert(!glas_moves_compile(&plan, "a-b"), "unassigned var");
+    mu_assert(glas_moves_compile(&plan, "ab-"), "drop all");
+    mu_assert(glas_moves_compile(&plan, "abc-cab"), "rotate");
+    mu_assert(0 == plan.linear_check, "rotate is linear");
+    int64_t n = 0;
+    glas_i64_push(g, 1);
+    glas_i64_push(g, 2);
+    glas_i64_push(g, 3);
+    glas_data_move_exec(g, &plan); // 3 1 2
+    mu_assert(glas_i64_peek(g, &n) && (2 == n), "rotate top");
+    glas_data_move(g, "abc-ba");  // 1 3
+    mu_assert(glas_i64_peek(g, &n) && (3 == n), "drop and swap");
+    glas_data_move(g, "ab-abab"); // 1 3 1 3
+    glas_data_move(g, "ab-b");    // 1 3 3
+    glas_data_move(g, "abc-a");   // 1
+    mu_assert(glas_i64_peek(g, &n) && (1 == n), "copy and drop");
+    mu_assert(0 == g->err, "no errors");
+
+    // large plans move items one at a time
+    char deep[GLAS_STACK_MAX + 4] = "a-";
+    memset(deep + 2, 'a', GLAS_STACK_MAX + 1);
+    deep[GLAS_STACK_MAX + 3] = 0;
+    glas_data_move(g, deep);
+    glas_data_drop(g, GLAS_STACK_MAX);
+    mu_assert(glas_i64_peek(g, &n) && (1 == n), "deep moves");
+    glas_data_drop(g, 1);
+    mu_assert(0 == g->err, "no errors on deep moves");
+
+    // copy of linear data
+    int x = 0;
+    glas_ptr_push(g, &x, (glas_refct){ 0 }, true);
+    glas_data_move(g, "a-aa");
+    mu_assert(0 != (g->err & GLAS_E_LINEARITY), "linear copy detected");
+    g->err = 0;
+    glas_data_move(g, "ab-ba");
+    mu_assert(0 == g->err, "linear swap is fine");
+    void* ptr = NULL;
+    glas_refct pin;
+    mu_assert(glas_ptr_pop(g, &ptr, &pin) && (&x == ptr), "linear pop");
+    mu_assert(glas_ptr_pop(g, &ptr, &pin) && (&x == ptr), "linear pop");
+}
+MU_TEST(test_gc_stack_snapshot) {
+    // shuffle binaries on stack and stash, spilling to overflow, while GC
+    // marks concurrently. Items must survive without per-write barriers.
+    glas* const g = test.g;
+    static size_t const window = 40;
+    uint64_t mirror[41];
+    size_t count = 0;
+    uint64_t next_id = 1;
+    uint64_t const goal = 4 + atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    struct timespec start = { 0 };
+    for(size_t iter = 0; ; ++iter) {
+        uint64_t const id = next_id++;
+        uint64_t const buf[2] = { id, ~id };
+        glas_binary_push(g, (uint8_t const*) buf, sizeof(buf));
+        mirror[count++] = id;
+        if(count >= 5) {
+            glas_data_move(g, "abcde-eabcd");
+            uint64_t const e = mirror[count - 1];
+            memmove(mirror + count - 4, mirror + count - 5, 4 * sizeof(uint64_t));
+            mirror[count - 5] = e;
+            glas_data_stash(g, 2);
+            glas_data_swap(g);
+            glas_data_stash(g, -2);
+            uint64_t const tmp = mirror[count - 3];
+            mirror[count - 3] = mirror[count - 4];
+            mirror[count - 4] = tmp;
+        }
+        if(count > window) {
+            glas_data_drop(g, 1);
+            --count;
+        }
+        if(0 == (iter % 256)) {
+            glas_rt_gc_trigger((iter & 256) ? GLAS_GC_FULL : GLAS_GC_MINOR);
+            if(goal <= atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire)) { break; }
+            if(!test_wait(&start, 0, 2000)) { break; }
+        }
+    }
+    size_t mismatch = 0;
+    while(count > 0) {
+        uint64_t const id = mirror[--count];
+        glas_os_thread_enter_busy();
+        glas_thread_stack_prep(g, 1, 0);
+        glas_cell* const cell = g->state->stack.data[g->state->stack.count - 1].cell;
+        uint64_t buf[2] = { 0, 0 };
+        bool const ok = GLAS_DATA_IS_PTR(cell) && (GLAS_TYPE_SMALL_BIN == cell->hdr.type_id) &&
+            (sizeof(buf) == cell->hdr.type_arg);
+        if(ok) { memcpy(buf, cell->small_bin, sizeof(buf)); }
+        glas_os_thread_exit_busy();
+        mismatch += (ok && (id == buf[0]) && (~id == buf[1])) ? 0 : 1;
+        glas_data_drop(g, 1);
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    mu_assert(0 == g->err, "no errors");
+}
+LOCAL size_t test_unp_walk(glas* g, int64_t (*expect)(size_t), size_t len) {
+    // walk the list on top of stack, counting mismatched items
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < len; ++ix) {
+        int64_t n = -1;
+        bool const ok = glas_unp(g); // L -- Hd Tl
+        glas_data_swap(g);
+        mismatch += (ok && glas_i64_peek(g, &n) && (n == expect(ix))) ? 0 : 1;
+        glas_data_drop(g, 1);
+    }
+    mismatch += glas_unp(g) ? 1 : 0; // unit tail
+    glas_data_drop(g, 1);
+    return mismatch;
+}
+LOCAL int64_t test_unp_byte(size_t ix) { return 1 + (int64_t)(ix % 255); }
+LOCAL int64_t test_unp_int(size_t ix) { return 1000 + (int64_t)ix; }
+LOCAL int64_t test_unp_rope(size_t ix) { return (ix < 3) ? test_unp_int(ix) : test_unp_byte(ix - 3); }
+LOCAL void test_push_int_array(glas* g, size_t len) {
+    glas_cell** const data = malloc(len * sizeof(glas_cell*));
+    glas_os_thread_enter_busy();
+    for(size_t ix = 0; ix < len; ++ix) {
+        data[ix] = glas_data_i64(test_unp_int(ix)).cell;
+    }
+    glas_thread_stack_cell_push(g, glas_cell_array_alloc(data, len));
+    glas_os_thread_exit_busy();
+    free(data);
+}
+MU_TEST(test_unpair) {
+    glas* const g = test.g;
+    uint8_t buf[3000];
+    for(size_t ix = 0; ix < sizeof(buf); ++ix) { buf[ix] = (uint8_t) test_unp_byte(ix); }
+    static size_t const bin_lens[] = { 5, 20, 100, 3000 }; // packed, small, medium, big
+    for(size_t ix = 0; ix < 4; ++ix) {
+        glas_binary_push(g, buf, bin_lens[ix]);
+        mu_assert_int_eq(0, (int) test_unp_walk(g, test_unp_byte, bin_lens[ix]));
+    }
+    static size_t const arr_lens[] = { 3, 100, 3000 }; // small, medium, big
+    for(size_t ix = 0; ix < 3; ++ix) {
+        test_push_int_array(g, arr_lens[ix]);
+        mu_assert_int_eq(0, (int) test_unp_walk(g, test_unp_int, arr_lens[ix]));
+    }
+    // rope: first 3 items of an array, then a binary
+    test_push_int_array(g, 10);
+    glas_binary_push(g, buf, 50);
+    glas_os_thread_enter_busy();
+    glas_cell* const bin = glas_thread_stack_pop_cell(g);
+    glas_cell* const arr = glas_thread_stack_pop_cell(g);
+    glas_thread_stack_cell_push(g, glas_cell_take_concat_alloc(3, arr, bin));
+    glas_os_thread_exit_busy();
+    mu_assert_int_eq(0, (int) test_unp_walk(g, test_unp_rope, 53));
+    // shrub (0b10, ())
+    uint64_t const stem = ((UINT64_C(0b10) << 1) | 1) << 61;
+    uint64_t const shrub = glas_cell_shrub_cons((glas_cell*)(stem | GLAS_DATA_TAG_BITS), 0);
+    glas_os_thread_enter_busy();
+    glas_thread_stack_cell_push(g, (glas_cell*)(shrub | GLAS_DATA_TAG_SHRUB));
+    glas_os_thread_exit_busy();
+    int64_t n = -1;
+    mu_assert(glas_unp(g), "shrub is pair");
+    glas_op const unp_op = { GLAS_OP_UNP, 0 };
+    mu_assert(0 == glas_data_exec(g, &unp_op, 1), "shrub tail is unit");
+    glas_data_drop(g, 1);
+    mu_assert(glas_i64_peek(g, &n) && (2 == n), "shrub head");
+    glas_data_drop(g, 1);
+    mu_assert(0 == g->err, "no errors");
+}
+LOCAL size_t test_rope_leaves(glas_cell* cell) {
+    if(0 == glas_rope_height(cell)) { return 1; }
+    return test_rope_leaves(cell->take_concat.left) + 
+           test_rope_leaves(cell->take_concat.right);
+}
+LOCAL glas_cell* test_stack_top(glas* g) {
+    return g->state->stack.data[g->state->stack.count - 1].cell;
+}
+LOCAL size_t test_list_mismatch(glas* g, int64_t const* model, size_t len, size_t stride) {
+    // compare indexed items of list on top of stack to model
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < len; ix += stride) {
+        int64_t n = -1;
+        glas_i64_push(g, (int64_t)ix);
+        glas_list_index(g); // L N -- L X
+        mismatch += (glas_i64_peek(g, &n) && (n == model[ix])) ? 0 : 1;
+        glas_data_drop(g, 1);
+    }
+    return mismatch;
+}
+MU_TEST(test_list_rope) {
+    glas* const g = test.g;
+    uint8_t buf[6000];
+    for(size_t ix = 0; ix < sizeof(buf); ++ix) { buf[ix] = (uint8_t) test_unp_byte(ix); }
+    size_t const max_len = 30000;
+    int64_t* const model = malloc(max_len * sizeof(int64_t));
+
+    // mixed binary and array segments of varied sizes
+    size_t len = 0;
+    glas_binary_push(g, buf, 0);
+    for(size_t ix = 0; (len + 500) < max_len; ++ix) {
+        size_t const seg = 1 + ((ix * 97) % 500);
+        size_t const offset = ix % 7;
+        if(2 == (ix % 3)) {
+            test_push_int_array(g, seg);
+        } else {
+            glas_binary_push(g, buf + offset, seg);
+        }
+        for(size_t k = 0; k < seg; ++k) {
+            model[len + k] = (2 == (ix % 3)) ? test_unp_int(k) : test_unp_byte(offset + k);
+        }
+        glas_list_append(g);
+        len += seg;
+    }
+    size_t const leaves = test_rope_leaves(test_stack_top(g));
+    mu_assert(glas_rope_height(test_stack_top(g)) <= 2 * (64 - clz64(leaves)), "balanced");
+    mu_assert_int_eq(0, (int) test_list_mismatch(g, model, len, 7));
+    
+    // split and rejoin
+    size_t const splits[] = { 0, 1, 333, len / 2, len - 1, len };
+    for(size_t ix = 0; ix < (sizeof(splits)/sizeof(splits[0])); ++ix) {
+        size_t const at = splits[ix];
+        int64_t n = -1;
+        glas_i64_push(g, (int64_t)at);
+        glas_list_split(g); // L R
+        if(at < len) {
+            glas_i64_push(g, 0);
+            glas_list_index(g);
+            mu_assert(glas_i64_peek(g, &n) && (n == model[at]), "head of right");
+            glas_data_drop(g, 1);
+        }
+        glas_data_swap(g);
+        if(at > 0) {
+            glas_i64_push(g, (int64_t)(at - 1));
+            glas_list_index(g);
+            mu_assert(glas_i64_peek(g, &n) && (n == model[at - 1]), "last of left");
+            glas_data_drop(g, 1);
+        }
+        glas_data_swap(g);
+        glas_list_append(g);
+    }
+    mu_assert_int_eq(0, (int) test_list_mismatch(g, model, len, 3));
+    glas_data_drop(g, 1);
+
+    // small appends coalesce, including cons lists
+    glas_binary_push(g, buf, 0);
+    for(size_t ix = 0; ix < 1000; ++ix) {
+        if(0 == (ix % 10)) {
+            glas_i64_push(g, test_unp_byte(ix));
+            glas_binary_push(g, buf, 0);
+            glas_mkp(g); // singleton cons list
+        } else {
+            glas_binary_push(g, buf + (ix % 255), 1);
+        }
+        model[ix] = test_unp_byte(ix);
+        glas_list_append(g);
+    }
+    mu_assert(test_rope_leaves(test_stack_top(g)) < 100, "coalesced");
+    mu_assert_int_eq(0, (int) test_list_mismatch(g, model, 1000, 1));
+    glas_data_drop(g, 1);
+
+    // slices of a buffer rejoin, medium or big
+    static size_t const bin_lens[] = { 2000, 6000 };
+    for(size_t ix = 0; ix < 2; ++ix) {
+        glas_binary_push(g, buf, bin_lens[ix]);
+        glas_i64_push(g, 1000);
+        glas_list_split(g);
+        glas_list_append(g);
+        glas_cell* const bin = test_stack_top(g);
+        mu_assert(GLAS_TYPE_BIG_BIN == bin->hdr.type_id, "slices rejoin");
+        mu_assert_int_eq((int) bin_lens[ix], (int) bin->big_bin.len);
+        mu_assert((0 == ix) == (bin == bin->big_bin.fptr), "medium rejoins owner");
+        glas_data_drop(g, 1);
+    }
+    mu_assert(0 == g->err, "no errors");
+
+    // out of range
+    glas_binary_push(g, buf, 10);
+    glas_i64_push(g, 11);
+    glas_list_split(g);
+    mu_assert(0 != (g->err & GLAS_E_TYPE), "split out of range");
+    glas_data_drop(g, 2);
+    g->err = 0;
+    free(model);
+}
+LOCAL bool test_len_is(glas* g, void (*op)(glas*), uint64_t expect) {
+    uint64_t n = UINT64_MAX;
+    op(g); // X -- X N
+    bool const ok = glas_u64_peek(g, &n) && (n == expect);
+    glas_data_drop(g, 1);
+    return ok;
+}
+MU_TEST(test_data_len) {
+    glas* const g = test.g;
+    uint8_t buf[6000] = { 0 };
+    static size_t const bin_lens[] = { 0, 5, 20, 100, 6000 };
+    for(size_t ix = 0; ix < 5; ++ix) {
+        glas_binary_push(g, buf, bin_lens[ix]);
+        mu_assert(test_len_is(g, glas_list_len, bin_lens[ix]), "binary len");
+        glas_data_drop(g, 1);
+    }
+    static size_t const arr_lens[] = { 3, 100, 3000 };
+    for(size_t ix = 0; ix < 3; ++ix) {
+        test_push_int_array(g, arr_lens[ix]);
+        mu_assert(test_len_is(g, glas_list_len, arr_lens[ix]), "array len");
+        glas_data_drop(g, 1);
+    }
+    // ropes, cons lists
+    glas_binary_push(g, buf, 0);
+    for(size_t ix = 0; ix < 200; ++ix) {
+        glas_binary_push(g, buf, 1 + ix);
+        glas_list_append(g);
+        glas_i64_push(g, 1);
+        glas_binary_push(g, buf, 0);
+        glas_mkp(g);
+        glas_list_append(g);
+    }
+    mu_assert(test_len_is(g, glas_list_len, 20300), "rope len");
+    glas_i64_push(g, 1);
+    glas_data_swap(g);
+    glas_mkp(g);
+    mu_assert(test_len_is(g, glas_list_len, 20301), "cons onto rope len");
+    glas_data_drop(g, 1);
+
+    // bitstrings of a few sizes, through stem cells
+    static size_t const bits_lens[] = { 0, 1, 31, 63, 64, 200, 1000 };
+    for(size_t ix = 0; ix < 7; ++ix) {
+        glas_binary_push(g, buf, 0);
+        for(size_t k = 0; k < bits_lens[ix]; ++k) {
+            if(0 == (k % 3)) { glas_mkl(g); } else { glas_mkr(g); }
+        }
+        mu_assert(test_len_is(g, glas_bits_len, bits_lens[ix]), "bits len");
+        glas_data_drop(g, 1);
+    }
+    // pushed bits compact into O(log N) views, walked by bits_len
+    static size_t const long_bits = 1000000;
+    glas_binary_push(g, buf, 0);
+    for(size_t k = 0; k < long_bits; ++k) {
+        if(0 == (k % 3)) { glas_mkl(g); } else { glas_mkr(g); }
+    }
+    mu_assert(test_len_is(g, glas_bits_len, long_bits), "long bits len");
+    size_t stems = 0, views = 0;
+    for(glas_cell* c = test_stack_top(g); GLAS_DATA_IS_PTR(c); ) {
+        if(GLAS_TYPE_STEM == c->hdr.type_id) {
+            ++stems;
+            c = c->stem.fby;
+        } else {
+            mu_assert(GLAS_TYPE_STEM_OF_BIN == c->hdr.type_id, "bits chain");
+            ++views;
+            c = c->stem_of_bin.fby;
+        }
+    }
+    mu_assert(stems <= (GLAS_STEM_CHAIN_MAX + 2), "stem chain bound");
+    mu_assert(views <= 20, "view chain bound"); // log2(1M / 1024)
+    size_t mismatch = 0;
+    for(size_t k = long_bits; k > (long_bits - 5000); --k) {
+        // bits pop in reverse of pushing
+        bool const bit = (0 != ((k - 1) % 3));
+        mismatch += (bit ? glas_unr(g) : glas_unl(g)) ? 0 : 1;
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    mu_assert(test_len_is(g, glas_bits_len, long_bits - 5000), "popped long bits len");
+    glas_data_drop(g, 1);
+
+    // rope height bounds the right spine walked by list_len
+    static size_t const leaf_count = 4096;
+    glas_binary_push(g, buf, 0);
+    for(size_t ix = 0; ix < leaf_count; ++ix) {
+        glas_binary_push(g, buf, 2 * GLAS_ROPE_LEAF_BYTES);
+        glas_list_append(g);
+    }
+    mu_assert(test_len_is(g, glas_list_len, leaf_count * 2 * GLAS_ROPE_LEAF_BYTES), "long rope len");
+    glas_cell* const rope = test_stack_top(g);
+    size_t spine = 0;
+    for(glas_cell* c = rope; 0 < glas_rope_height(c); c = c->take_concat.right) { ++spine; }
+    mu_assert(spine <= glas_rope_height(rope), "spine within height");
+    mu_assert(glas_rope_height(rope) <= 18, "rope height bound"); // 1.44 * log2(4096)
+    glas_data_drop(g, 1);
+
+    glas_i64_push(g, -5);
+    mu_assert(test_len_is(g, glas_bits_len, 3), "negative int bits len");
+    glas_data_drop(g, 1);
+    mu_assert(0 == g->err, "no errors");
+
+    // type errors
+    glas_i64_push(g, 7);
+    glas_list_len(g);
+    mu_assert(0 != (g->err & GLAS_E_TYPE), "number is not a list");
+    g->err = 0;
+    glas_binary_push(g, buf, 10);
+    glas_bits_len(g);
+    mu_assert(0 != (g->err & GLAS_E_TYPE), "binary is not a bitstring");
+    glas_data_drop(g, 2);
+    g->err = 0;
+}
 MU_TEST(test_finalizers) {
     // this tests that items are garbage collected, that finalizers are run,
     // and that a subset of items are held properly across GC cycles.
@@ -3761,30 +7810,771 @@ MU_TEST(test_finalizers) {
                          (int) atomic_load_explicit(counts + stripe, memory_order_relaxed));
         glas_data_drop(test.g, 1);
         glas_rt_gc_trigger(GLAS_GC_FULL);
-        static size_t const GC_WAIT_STEP_USEC = 5000; // check every 5ms
-        static size_t const GC_WAIT_MAX_STEP_COUNT = 1000000 / GC_WAIT_STEP_USEC; // ~1sec
-        size_t step_count = 0;
-        do {
-            size_t elem_count = atomic_load_explicit(counts + stripe, memory_order_relaxed);
-            //debug("strip %lu at %lu items", stripe, elem_count);
-            if(0 == elem_count) {
-                break;
-            } else {
-                struct timespec tm = { .tv_sec = 0, .tv_nsec = 1000 * GC_WAIT_STEP_USEC };
-                nanosleep(&tm, NULL);
-            }
-        } while(GC_WAIT_MAX_STEP_COUNT > ++step_count);
+        test_wait_until(counts + stripe, 0);
         mu_assert_int_eq(0, (int) atomic_load_explicit(counts + stripe, memory_order_relaxed));
     }
 }
 
+LOCAL int64_t test_int_item(size_t ix) {
+    // mostly small values, some that need full width
+    return (0 == (ix % 1000)) ? (INT64_MAX - (int64_t)ix) :
+           (7 == (ix % 1000)) ? INT64_MIN : 
+           ((int64_t)(ix * 37) - 50000);
+}
+MU_TEST(test_int_array) {
+    glas* const g = test.g;
+    static size_t const len = 100000;
+    int64_t* const src = malloc(len * sizeof(int64_t));
+    int64_t* const dst = malloc(len * sizeof(int64_t));
+    for(size_t ix = 0; ix < len; ++ix) { src[ix] = test_int_item(ix); }
+    glas_i64_array_push(g, src, len);
+    mu_assert(GLAS_TYPE_INT_ARR == test_stack_top(g)->hdr.type_id, "unboxed");
+    mu_assert(test_len_is(g, glas_list_len, len), "int array len");
+    mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 2), "gc cycles");
+
+    // bulk peek, narrow peek stops at first item out of range
+    size_t amt = 0;
+    mu_assert(glas_i64_array_peek(g, 0, len, dst, &amt), "peek all");
+    mu_assert((len == amt) && (0 == memcmp(src, dst, len * sizeof(int64_t))), "peek data");
+
+    // a cons list is walked once, not once per chunk
+    glas_i64_push(g, 0); // unit
+    for(size_t ix = len; ix > 0; --ix) {
+        glas_i64_push(g, src[ix - 1]);
+        glas_data_swap(g);
+        glas_mkp(g);
+    }
+    memset(dst, 0, len * sizeof(int64_t));
+    mu_assert(glas_i64_array_peek(g, 0, len, dst, &amt), "peek cons list");
+    mu_assert((len == amt) && (0 == memcmp(src, dst, len * sizeof(int64_t))), "cons list data");
+    mu_assert(glas_i64_array_peek(g, 777, len, dst, &amt), "peek cons offset");
+    mu_assert(((len - 777) == amt) && (0 == memcmp(src + 777, dst, amt * sizeof(int64_t))), "cons offset data");
+    glas_data_drop(g, 1);
+    int32_t dst32[16];
+    mu_assert(!glas_i32_array_peek(g, 1, 16, dst32, &amt), "peek i32 range");
+    mu_assert((6 == amt) && (dst32[5] == (int32_t)src[6]), "peek i32 partial");
+    
+    // index, split, and rejoin
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < len; ix += 997) {
+        int64_t n = 0;
+        glas_i64_push(g, (int64_t)ix);
+        glas_list_index(g);
+        mismatch += (glas_i64_peek(g, &n) && (n == src[ix])) ? 0 : 1;
+        glas_data_drop(g, 1);
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    glas_i64_push(g, 40000);
+    glas_list_split(g);
+    mu_assert(GLAS_TYPE_INT_ARR == test_stack_top(g)->hdr.type_id, "slice");
+    mu_assert(glas_i64_array_peek(g, 0, len, dst, &amt), "peek slice");
+    mu_assert((60000 == amt) && (0 == memcmp(src + 40000, dst, amt * sizeof(int64_t))), "slice data");
+    glas_list_append(g);
+    glas_cell* const arr = test_stack_top(g);
+    mu_assert((GLAS_TYPE_INT_ARR == arr->hdr.type_id) && (len == arr->int_arr.len), "slices rejoin");
+    glas_data_drop(g, 1);
+
+    // unp walk over a narrow array
+    int8_t small[40];
+    for(size_t ix = 0; ix < 40; ++ix) { small[ix] = (int8_t)(1 + ix * 3); }
+    glas_i8_array_push(g, small, 40);
+    for(size_t ix = 0; ix < 40; ++ix) {
+        int64_t n = 0;
+        mu_assert(glas_unp(g), "int array pair");
+        glas_data_swap(g);
+        mu_assert(glas_i64_peek(g, &n) && (n == small[ix]), "int array head");
+        glas_data_drop(g, 1);
+    }
+    glas_data_drop(g, 1);
+
+    // appending counters one at a time stays unboxed
+    int16_t counters[10] = { -1, -2, -3, -4, -5, -6, -7, -8, -9, -10 };
+    glas_i16_array_push(g, counters, 10);
+    for(size_t ix = 0; ix < 500; ++ix) {
+        glas_i64_push(g, -1000 - (int64_t)ix);
+        glas_i64_push(g, 0); // unit
+        glas_mkp(g);
+        glas_list_append(g);
+    }
+    glas_cell* const top = test_stack_top(g);
+    size_t const leaves = test_rope_leaves(top);
+    mu_assert(leaves < 10, "counters coalesce");
+    mu_assert(glas_i64_array_peek(g, 0, len, dst, &amt) && (510 == amt), "peek counters");
+    mismatch = 0;
+    for(size_t ix = 0; ix < 510; ++ix) {
+        mismatch += (dst[ix] == ((ix < 10) ? counters[ix] : (-1000 - (int64_t)(ix - 10)))) ? 0 : 1;
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    glas_data_drop(g, 1);
+
+    // mixed widths merge into the wider
+    int32_t const wide[4] = { 100000, -100000, 7, 8 };
+    glas_i8_array_push(g, small, 6);
+    glas_i32_array_push(g, wide, 4);
+    glas_list_append(g);
+    glas_cell* const merged = test_stack_top(g);
+    mu_assert((GLAS_TYPE_INT_ARR == merged->hdr.type_id) && (2 == merged->hdr.type_arg), "widened");
+    glas_data_drop(g, 1);
+    mu_assert(0 == g->err, "no errors");
+    free(src);
+    free(dst);
+}
+LOCAL bool test_binary_is(glas* g, uint8_t const* expect, size_t len) {
+    // compare binary on top of stack
+    int16_t* const dst = malloc((len + 1) * sizeof(int16_t));
+    size_t amt = 0;
+    bool const ok = glas_i16_array_peek(g, 0, len + 1, dst, &amt) && (len == amt);
+    size_t mismatch = 0;
+    for(size_t ix = 0; ok && (ix < len); ++ix) {
+        mismatch += (dst[ix] == expect[ix]) ? 0 : 1;
+    }
+    free(dst);
+    return ok && (0 == mismatch);
+}
+MU_TEST(test_bits_of_bin) {
+    glas* const g = test.g;
+    static size_t const len = 100000;
+    uint8_t* const src = malloc(len);
+    uint8_t* const rot = malloc(len);
+    for(size_t ix = 0; ix < len; ++ix) { src[ix] = (uint8_t)((ix * 2654435761u) >> 13); }
+    for(size_t ix = 0; ix < len; ++ix) {
+        // rotated left by 3 bits
+        rot[ix] = (uint8_t)((src[ix] << 3) | (src[(ix + 1) % len] >> 5));
+    }
+    glas_binary_push(g, src, len);
+    glas_cell* const bin = test_stack_top(g);
+    glas_bits_of_bin(g);
+    glas_cell* const view = test_stack_top(g);
+    mu_assert(GLAS_TYPE_STEM_OF_BIN == view->hdr.type_id, "viewed");
+    mu_assert(bin == view->stem_of_bin.binary, "shared");
+    mu_assert(test_len_is(g, glas_bits_len, 8 * len), "view len");
+    mu_assert((8 * len) == glas_sc_stem_len(g->state->stack.data[g->state->stack.count - 1]), "stem len");
+    mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 2), "gc cycles");
+
+    // unl and unr read the leading bits
+    glas_data_copy(g, 1);
+    size_t mismatch = 0;
+    for(size_t ix = 0; ix < 200; ++ix) {
+        bool const bit = (0 != (src[ix / 8] & (0x80 >> (ix % 8))));
+        mismatch += (bit ? glas_unr(g) : glas_unl(g)) ? 0 : 1;
+    }
+    mu_assert_int_eq(0, (int) mismatch);
+    mu_assert(test_len_is(g, glas_bits_len, (8 * len) - 200), "popped len");
+    glas_data_drop(g, 1);
+
+    // split within the view, then rejoin
+    glas_u64_push(g, 12345);
+    glas_bits_split(g);
+    mu_assert(GLAS_TYPE_STEM_OF_BIN == test_stack_top(g)->hdr.type_id, "split view");
+    mu_assert(test_len_is(g, glas_bits_len, (8 * len) - 12345), "split right len");
+    glas_data_swap(g);
+    mu_assert(test_len_is(g, glas_bits_len, 12345), "split left len");
+    glas_data_swap(g);
+    glas_bits_append(g);
+    glas_cell* const rejoined = test_stack_top(g);
+    mu_assert((GLAS_TYPE_STEM_OF_BIN == rejoined->hdr.type_id) &&
+              ((8 * len) == rejoined->stem_of_bin.bit_len) &&
+              (GLAS_VAL_UNIT == rejoined->stem_of_bin.fby), "rejoined");
+
+    // rotate by three bits, then convert back
+    glas_data_copy(g, 1);
+    glas_u64_push(g, 3);
+    glas_bits_split(g);
+    glas_data_swap(g);
+    glas_bits_append(g);
+    mu_assert(test_len_is(g, glas_bits_len, 8 * len), "rotated len");
+    glas_bits_to_bin(g);
+    mu_assert(test_binary_is(g, rot, len), "rotated binary");
+    glas_cell* const segs = test_stack_top(g);
+    mu_assert(0 < glas_rope_height(segs), "rotated in segments");
+    size_t max_leaf = 0;
+    for(uint64_t ix = 0; ix < len; ) {
+        uint64_t offset = ix, avail = len - ix;
+        glas_rope_leaf_at(segs, &offset, &avail);
+        max_leaf = (avail > max_leaf) ? avail : max_leaf;
+        ix += avail;
+    }
+    mu_assert(max_leaf <= GLAS_BIN_WRITER_SEGMENT, "segment bound");
+    glas_data_drop(g, 1);
+
+    // a one byte prefix is written alone, and the view still shared
+    glas_data_copy(g, 1);
+    for(size_t ix = 0; ix < 8; ++ix) {
+        if(0 == (ix % 3)) { glas_mkl(g); } else { glas_mkr(g); }
+    }
+    glas_bits_to_bin(g);
+    glas_cell* const prefixed = test_stack_top(g);
+    mu_assert((0 < glas_rope_height(prefixed)) && (1 == prefixed->take_concat.left_len) &&
+              (bin == prefixed->take_concat.right), "prefix shares view");
+    glas_data_drop(g, 1);
+    glas_bits_to_bin(g);
+    mu_assert(bin == test_stack_top(g), "aligned view returns binary");
+    glas_data_drop(g, 1);
+
+    // ropes of binaries, and small binaries via stem cells
+    glas_binary_push(g, src, 1000);
+    glas_binary_push(g, src + 1000, 5);
+    glas_list_append(g);
+    glas_binary_push(g, src + 1005, 3000);
+    glas_list_append(g);
+    glas_bits_of_bin(g);
+    mu_assert(test_len_is(g, glas_bits_len, 8 * 4005), "rope bits len");
+    glas_u64_push(g, 8 * 999 + 4);
+    glas_bits_split(g);
+    glas_bits_append(g);
+    glas_bits_to_bin(g);
+    mu_assert(test_binary_is(g, src, 4005), "rope round trip");
+    glas_data_drop(g, 1);
+    glas_binary_push(g, src, 3);
+    glas_bits_of_bin(g);
+    mu_assert(!glas_cell_is_stem_of_bin(test_stack_top(g)), "small stem");
+    mu_assert(test_len_is(g, glas_bits_len, 24), "small bits len");
+    glas_bits_to_bin(g);
+    mu_assert(test_binary_is(g, src, 3), "small round trip");
+    glas_data_drop(g, 1);
+    mu_assert(0 == g->err, "no errors");
+
+    // type errors
+    glas_binary_push(g, src, 100);
+    glas_bits_of_bin(g);
+    glas_u64_push(g, 5);
+    glas_bits_split(g);
+    glas_data_drop(g, 1);
+    glas_bits_to_bin(g);
+    mu_assert(0 != (g->err & GLAS_E_TYPE), "to_bin of 5 bits");
+    g->err = 0;
+    glas_data_drop(g, 1);
+    glas_i64_push(g, 300);
+    glas_i64_push(g, 0);
+    glas_mkp(g);
+    glas_bits_of_bin(g);
+    mu_assert(0 != (g->err & GLAS_E_TYPE), "of_bin of non-byte");
+    glas_data_drop(g, 1);
+    g->err = 0;
+    free(src);
+    free(rot);
+}
+MU_TEST(test_gc_decref) {
+    // big binaries are freed inline by GC; client decrefs span several
+    // batches and must all reach the decref workers.
+    static size_t const bin_count = 64;
+    static size_t const ptr_count = 3 * GLAS_GC_DECREF_BATCH + 1;
+    uint64_t const inline_start = atomic_load_explicit(&glas_rt.stat.decref_inline, memory_order_relaxed);
+    uint64_t const queued_start = atomic_load_explicit(&glas_rt.stat.decref_queued, memory_order_relaxed);
+    uint8_t buf[2 * GLAS_BLOCK_DATA_MAX];
+    memset(buf, 0x5A, sizeof(buf));
+    for(size_t ix = 0; ix < bin_count; ++ix) {
+        glas_binary_push(test.g, buf, sizeof(buf));
+        glas_data_drop(test.g, 1);
+    }
+    _Atomic(size_t) count;
+    atomic_init(&count, 0);
+    for(size_t ix = 0; ix < ptr_count; ++ix) {
+        glas_refct pin = { .refct_obj = &count, .refct_upd = test_fin_refct_upd };
+        glas_incref(pin);
+        glas_ptr_push(test.g, NULL, pin, false);
+        glas_data_drop(test.g, 1);
+    }
+    mu_assert_int_eq((int) ptr_count, (int) atomic_load_explicit(&count, memory_order_relaxed));
+    mu_check(test_gc_wait_cycles(GLAS_GC_FULL, 2));
+    mu_check(test_wait_until(&count, 0));
+    mu_check(bin_count <= (atomic_load_explicit(&glas_rt.stat.decref_inline, memory_order_relaxed) - inline_start));
+    mu_check(ptr_count <= (atomic_load_explicit(&glas_rt.stat.decref_queued, memory_order_relaxed) - queued_start));
+}
+MU_TEST(test_gc_fin_cards) {
+    // card bits spread over four cells each, and gather back
+    mu_check(UINT64_C(0xF) == glas_card_bits_to_cells(1));
+    mu_check(UINT64_C(0xF0F0) == glas_card_bits_to_cells(0xA));
+    mu_check(UINT64_C(0xF000000000000000) == glas_card_bits_to_cells(UINT64_C(1) << 15));
+    mu_check(0xA == glas_cell_bits_to_cards(UINT64_C(0x1020)));
+    mu_check(0xFFFF == glas_cell_bits_to_cards(UINT64_C(0x8888888888888888)));
+
+    // a live finalizer is folded into its page card and keeps it; once 
+    // dropped, the finalizer runs exactly once.
+    _Atomic(size_t) count;
+    atomic_init(&count, 0);
+    glas_refct pin = { .refct_obj = &count, .refct_upd = test_fin_refct_upd };
+    glas_incref(pin);
+    glas_ptr_push(test.g, NULL, pin, false);
+    mu_check(test_gc_wait_cycles(GLAS_GC_FULL, 2));
+    glas_os_thread_enter_busy();
+    glas_stack* const s = &(test.g->state->stack);
+    glas_cell* const cell = s->data[s->count - 1].cell;
+    glas_page* const page = glas_page_from_internal_addr(cell);
+    size_t const card = (((uintptr_t)cell) - ((uintptr_t)page)) >> GLAS_HEAP_CARD_SIZE_LG2;
+    bool const has_card = 0 != ((UINT64_C(1) << (card % 64)) & 
+        atomic_load_explicit(page->fcards + (card / 64), memory_order_relaxed));
+    bool const has_fin = 0 != (GLAS_GCBITS_FIN & 
+        atomic_load_explicit(&(cell->hdr.gcbits), memory_order_relaxed));
+    glas_os_thread_exit_busy();
+    mu_assert(has_card, "finalizer card");
+    mu_assert(has_fin, "finalizer gcbit");
+    mu_assert_int_eq(1, (int) atomic_load_explicit(&count, memory_order_relaxed));
+    glas_data_drop(test.g, 1);
+    uint64_t const fin_pages = atomic_load_explicit(&glas_rt.stat.gc_fin_pages, memory_order_relaxed);
+    mu_check(test_gc_wait_cycles(GLAS_GC_FULL, 2));
+    mu_check(test_wait_until(&count, 0));
+    uint64_t const visited = atomic_load_explicit(&glas_rt.stat.gc_fin_pages, memory_order_relaxed) - fin_pages;
+    // the pass visits only pages flagged with finalizers, not the heap
+    mu_assert((0 < visited) && (visited <= 4), "finalizer pages visited");
+}
+MU_TEST(test_medium_blocks) {
+    // medium binaries and arrays are held in size-class pages and must
+    // survive GC while rooted, even as we churn through garbage.
+    static size_t const keep_count = 16;
+    uint8_t buf[GLAS_BLOCK_DATA_MAX + 64];
+    for(size_t ix = 0; ix < sizeof(buf); ++ix) {
+        buf[ix] = (uint8_t)(ix * 7);
+    }
+    glas_os_thread_enter_busy();
+    for(size_t ix = 0; ix < keep_count; ++ix) {
+        size_t const len = 25 + ((ix * 577) % (GLAS_BLOCK_DATA_MAX - 24));
+        glas_cell* const bin = glas_cell_binary_alloc(buf, len);
+        mu_assert(GLAS_TYPE_BIG_BIN == bin->hdr.type_id, "medium binary type");
+        mu_assert(bin == bin->big_bin.fptr, "medium binary is own buffer");
+        glas_page* const page = glas_page_from_internal_addr(bin);
+        mu_assert_int_eq((int) glas_block_size_class(len), (int) page->size_class);
+        glas_thread_stack_cell_push(test.g, bin);
+    }
+    glas_cell* arr_data[8] = { GLAS_VAL_UNIT, GLAS_VAL_UNIT, GLAS_VAL_UNIT, GLAS_VAL_UNIT,
+                               GLAS_VAL_UNIT, GLAS_VAL_UNIT, GLAS_VAL_UNIT, GLAS_VAL_UNIT };
+    arr_data[3] = glas_thread_stack_pop_cell(test.g); // hide one binary in the array
+    glas_cell* const arr = glas_cell_array_alloc(arr_data, 8);
+    mu_assert(arr == arr->big_arr.fptr, "medium array is own buffer");
+    glas_thread_stack_cell_push(test.g, arr);
+    glas_os_thread_exit_busy();
+
+    for(size_t round = 0; round < 3; ++round) {
+        glas_os_thread_enter_busy();
+        for(size_t ix = 0; ix < 20000; ++ix) {
+            (void) glas_cell_binary_alloc(buf, 25 + (ix % 2000)); // garbage
+        }
+        glas_os_thread_exit_busy();
+        mu_assert(test_gc_wait_cycles(GLAS_GC_MINOR, 1), "GC did not run");
+    }
+
+    glas_os_thread_enter_busy();
+    glas_stack* const s = &(test.g->state->stack);
+    mu_assert_int_eq((int) keep_count, (int) s->count);
+    glas_cell* const arr_kept = s->data[s->count - 1].cell;
+    mu_assert((GLAS_TYPE_BIG_ARR == arr_kept->hdr.type_id) && (8 == arr_kept->big_arr.len), "array kept");
+    size_t bad_bytes = 0;
+    for(size_t ix = 0; ix < keep_count; ++ix) {
+        size_t const len = 25 + ((ix * 577) % (GLAS_BLOCK_DATA_MAX - 24));
+        glas_cell* const bin = (ix == (keep_count - 1)) ? arr_kept->big_arr.data[3] : s->data[ix].cell;
+        mu_assert(len == bin->big_bin.len, "binary length kept");
+        bad_bytes += (0 == memcmp(buf, bin->big_bin.data, len)) ? 0 : 1;
+    }
+    glas_os_thread_exit_busy();
+    mu_assert_int_eq(0, (int) bad_bytes);
+    glas_data_drop(test.g, (uint8_t) keep_count);
+}
+
+MU_TEST(test_gc_cards) {
+    // an old cell updated to reference a young cell must keep it alive
+    // through minor GC cycles, which don't trace old cells.
+    uint8_t buf[24];
+    memset(buf, 0x5A, sizeof(buf));
+    glas_os_thread_enter_busy();
+    glas_cell* arr_data[3] = { GLAS_VAL_UNIT, GLAS_VAL_UNIT, GLAS_VAL_UNIT };
+    glas_thread_stack_cell_push(test.g, glas_cell_array_alloc(arr_data, 3));
+    glas_os_thread_exit_busy();
+    mu_assert(test_gc_wait_cycles(GLAS_GC_MINOR, 1), "GC did not run"); // arr is old
+
+    // cells may move in GC, so we reload 'arr' from the stack
+    glas_os_thread_enter_busy();
+    glas_stack* const s = &(test.g->state->stack);
+    glas_cell* const arr_old = s->data[s->count - 1].cell;
+    glas_cell* const bin = glas_cell_binary_alloc(buf, sizeof(buf));
+    bool const bin_young = GLAS_DATA_IS_PTR(bin) && (GLAS_TYPE_SMALL_BIN == bin->hdr.type_id);
+    glas_cell_slot_write(arr_old, arr_old->small_arr + 1, bin);
+    glas_os_thread_exit_busy();
+    mu_assert(bin_young, "young binary");
+
+    uint64_t const minor_start = atomic_load_explicit(&glas_rt.stat.gc_minor, memory_order_relaxed);
+    memset(buf, 0xA5, sizeof(buf));
+    for(size_t round = 0; round < 3; ++round) {
+        glas_os_thread_enter_busy();
+        for(size_t ix = 0; ix < 50000; ++ix) {
+            (void) glas_cell_binary_alloc(buf, sizeof(buf)); // garbage
+        }
+        glas_os_thread_exit_busy();
+        mu_assert(test_gc_wait_cycles(GLAS_GC_MINOR, 1), "GC did not run");
+    }
+    uint64_t const minor_end = atomic_load_explicit(&glas_rt.stat.gc_minor, memory_order_relaxed);
+    mu_assert(minor_end > minor_start, "expecting minor GC cycles");
+
+    glas_os_thread_enter_busy();
+    glas_cell* const arr = s->data[s->count - 1].cell;
+    glas_cell* const bin_kept = arr->small_arr[1];
+    bool const bin_ok = GLAS_DATA_IS_PTR(bin_kept) && 
+                        (GLAS_TYPE_SMALL_BIN == bin_kept->hdr.type_id) && 
+                        (sizeof(buf) == bin_kept->hdr.type_arg) &&
+                        (0x5A == bin_kept->small_bin[0]) && 
+                        (0x5A == bin_kept->small_bin[sizeof(buf)-1]);
+    glas_os_thread_exit_busy();
+    mu_assert(bin_ok, "young binary kept");
+    glas_data_drop(test.g, 1);
+}
+MU_TEST(test_gc_compact) {
+    // sparse pages are evacuated; rooted data must survive the move. We 
+    // keep one binary in eight, linked into a list on the stack.
+    static size_t const keep_count = 30000;
+    static size_t const garbage_ratio = 7;
+    uint8_t buf[24];
+    memset(buf, 0x3C, sizeof(buf));
+    glas_os_thread_enter_busy();
+    glas_thread_stack_cell_push(test.g, GLAS_VAL_UNIT);
+    for(size_t ix = 0; ix < keep_count; ++ix) {
+        for(size_t g = 0; g < garbage_ratio; ++g) {
+            (void) glas_cell_binary_alloc(buf, sizeof(buf));
+        }
+        memcpy(buf, &ix, sizeof(ix));
+        glas_cell* node[2];
+        node[0] = glas_cell_binary_alloc(buf, sizeof(buf));
+        node[1] = glas_thread_stack_pop_cell(test.g);
+        glas_thread_stack_cell_push(test.g, glas_cell_array_alloc(node, 2));
+    }
+    glas_os_thread_exit_busy();
+
+    uint64_t const evac_start = atomic_load_explicit(&glas_rt.stat.gc_evac_pages, memory_order_relaxed);
+    mu_assert(test_gc_wait_cycles(GLAS_GC_COMPACT, 3), "GC did not run");
+    uint64_t const evac_end = atomic_load_explicit(&glas_rt.stat.gc_evac_pages, memory_order_relaxed);
+    mu_assert(evac_end > evac_start, "expecting evacuated pages");
+
+    glas_os_thread_enter_busy();
+    glas_stack* const s = &(test.g->state->stack);
+    glas_cell* node = s->data[s->count - 1].cell;
+    size_t bad_count = 0;
+    for(size_t ix = keep_count; ix > 0; --ix) {
+        size_t const expect = ix - 1;
+        glas_cell* const bin = node->small_arr[0];
+        bad_count += ((GLAS_TYPE_SMALL_BIN == bin->hdr.type_id) &&
+                      (sizeof(buf) == bin->hdr.type_arg) &&
+                      (0 == memcmp(&expect, bin->small_bin, sizeof(expect))) &&
+                      (0x3C == bin->small_bin[sizeof(buf)-1])) ? 0 : 1;
+        node = node->small_arr[1];
+    }
+    bool const list_end = (GLAS_VAL_UNIT == node);
+    glas_os_thread_exit_busy();
+    mu_assert_int_eq(0, (int) bad_count);
+    mu_assert(list_end, "list length kept");
+    glas_data_drop(test.g, 1);
+}
+MU_TEST(test_heap_reclaim) {
+    // after a spike of garbage, GC should return most pages to the OS
+    static size_t const spike_pages = 40;
+    uint8_t buf[24];
+    memset(buf, 0x69, sizeof(buf));
+    uint64_t const free_start = atomic_load_explicit(&glas_rt.stat.page_free, memory_order_relaxed);
+    glas_os_thread_enter_busy(); // GC cannot recycle pages until we exit
+    for(size_t ix = 0; ix < (spike_pages * GLAS_PAGE_CELL_COUNT); ++ix) {
+        (void) glas_cell_binary_alloc(buf, sizeof(buf));
+    }
+    size_t const peak = atomic_load_explicit(&glas_rt.alloc.page_count, memory_order_relaxed);
+    glas_os_thread_exit_busy();
+    mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 3), "GC did not run");
+    size_t const after = atomic_load_explicit(&glas_rt.alloc.page_count, memory_order_relaxed);
+    uint64_t const free_end = atomic_load_explicit(&glas_rt.stat.page_free, memory_order_relaxed);
+    mu_assert(free_end > free_start, "expecting pages returned to OS");
+    mu_assert((after + (spike_pages / 2)) < peak, "expecting heap to shrink");
+}
+MU_TEST(test_numa_pages) {
+    // pages are recycled per node; single-node fallback is node 0
+    mu_assert((1 <= glas_rt.alloc.node_count) && 
+              (GLAS_NUMA_NODES_MAX >= glas_rt.alloc.node_count), "node count");
+    uint8_t buf[24] = { 0 };
+    glas_os_thread_enter_busy();
+    glas_cell* const cell = glas_cell_binary_alloc(buf, sizeof(buf));
+    size_t const node = glas_page_from_internal_addr(cell)->node;
+    // a page freed from the thread cache returns to its own node's list
+    glas_os_thread* const t = glas_os_thread_get();
+    glas_page* const page = glas_rt_page_alloc(0, node);
+    size_t const page_node = page->node;
+    page->next = t->alloc[0].cache;
+    t->alloc[0].cache = page;
+    glas_os_thread_drain_pages(t);
+    glas_alloc_l* const avail = glas_rt_avail(page_node, 0);
+    glas_page* pages = glas_allocl_take_all(avail);
+    bool returned = false;
+    while(NULL != pages) {
+        glas_page* const p = pages;
+        pages = p->next;
+        p->next = NULL;
+        returned = returned || (p == page);
+        glas_allocl_push(avail, p);
+    }
+    glas_os_thread_exit_busy();
+    mu_assert(node < glas_rt.alloc.node_count, "page node");
+    mu_assert(returned, "freed page on its node's avail list");
+    if(1 == glas_rt.alloc.node_count) {
+        mu_assert_int_eq(0, (int) glas_numa_node_current());
+    }
+}
+typedef struct test_page_lists_ctx {
+    glas_alloc_l list;
+    size_t rounds;
+} test_page_lists_ctx;
+LOCAL void* test_page_lists_thread(void* arg) {
+    test_page_lists_ctx* const ctx = arg;
+    for(size_t ix = 0; ix < ctx->rounds; ++ix) {
+        glas_page* const first = glas_allocl_try_pop_batch(&(ctx->list), 1 + (ix % 3));
+        if(NULL == first) { 
+            sched_yield();
+            continue; 
+        }
+        glas_page* last = first;
+        size_t count = 1;
+        while(NULL != last->next) { last = last->next; ++count; }
+        glas_allocl_push_chain(&(ctx->list), first, last, count);
+    }
+    return NULL;
+}
+MU_TEST(test_page_lists) {
+    // threads race to pop and push batches; no page lost or duplicated.
+    // Only page headers are touched, so we don't need real heap pages.
+    static size_t const page_count = 12;
+    static size_t const thread_count = 4;
+    glas_page* pages[page_count];
+    test_page_lists_ctx ctx = { .rounds = 50000 };
+    for(size_t ix = 0; ix < page_count; ++ix) {
+        pages[ix] = aligned_alloc(GLAS_HEAP_PAGE_SIZE, GLAS_HEAP_PAGE_SIZE);
+        mu_assert(NULL != pages[ix], "aligned_alloc");
+        pages[ix]->next = NULL;
+        glas_allocl_push(&(ctx.list), pages[ix]);
+    }
+    pthread_t threads[thread_count];
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_create(threads + ix, NULL, &test_page_lists_thread, &ctx);
+    }
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_join(threads[ix], NULL);
+    }
+    size_t const count_final = atomic_load_explicit(&(ctx.list.page_count), memory_order_relaxed);
+    size_t found = 0;
+    bool seen[page_count];
+    memset(seen, 0, sizeof(seen));
+    glas_page* page = glas_allocl_take_all(&(ctx.list));
+    while(NULL != page) {
+        for(size_t ix = 0; ix < page_count; ++ix) {
+            if((page == pages[ix]) && !seen[ix]) { 
+                seen[ix] = true; // detect duplicates
+                ++found;
+            }
+        }
+        page = page->next;
+    }
+    for(size_t ix = 0; ix < page_count; ++ix) {
+        free(pages[ix]);
+    }
+    mu_assert_int_eq((int) page_count, (int) count_final);
+    mu_assert_int_eq((int) page_count, (int) found);
+}
+MU_TEST(test_gc_pacer) {
+    // allocation alone wakes GC once mutators pass the trigger page
+    uint8_t buf[24];
+    memset(buf, 0x77, sizeof(buf));
+    uint64_t const cycle_start = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    uint64_t const trigger_start = atomic_load_explicit(&glas_rt.gc.pacer.trigger_at, memory_order_relaxed);
+    uint64_t const paced_start = atomic_load_explicit(&glas_rt.stat.gc_paced, memory_order_relaxed);
+    for(size_t round = 0; round < 10000; ++round) {
+        glas_os_thread_enter_busy();
+        for(size_t ix = 0; ix < 5000; ++ix) {
+            (void) glas_cell_binary_alloc(buf, sizeof(buf)); // garbage
+        }
+        glas_os_thread_exit_busy();
+        sched_yield(); // let a woken GC run
+        // Four cycle starts: up to two may still follow requests from prior
+        // tests (a pending trigger, then its full follow-up), so at least two
+        // were begun by allocation. The idle timeout could also start those,
+        // so we separately check the pacer posted the wakeups.
+        if(atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire) >= (cycle_start + 4)) {
+            break;
+        }
+    }
+    uint64_t const cycle_end = atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+    uint64_t const trigger_end = atomic_load_explicit(&glas_rt.gc.pacer.trigger_at, memory_order_relaxed);
+    uint64_t const paced = atomic_load_explicit(&glas_rt.stat.gc_paced, memory_order_relaxed) - paced_start;
+    mu_assert(cycle_end >= (cycle_start + 4), "expecting paced GC cycles");
+    mu_assert(paced >= 2, "expecting allocation to wake GC");
+    mu_assert(trigger_end > trigger_start, "expecting pacer to advance trigger");
+}
+MU_TEST(test_gc_prefetch) {
+    // tracing in either order marks the same data
+    glas_os_thread_enter_busy();
+    glas_cell* node[2] = { GLAS_VAL_UNIT, GLAS_VAL_UNIT };
+    for(size_t ix = 0; ix < 1000; ++ix) {
+        node[1] = glas_cell_array_alloc(node, 2); // right spine
+        node[0] = glas_cell_array_alloc(node, 2); // nested left
+    }
+    glas_thread_stack_cell_push(test.g, node[0]);
+    glas_os_thread_exit_busy();
+    size_t counts[2];
+    bool const prior = atomic_load_explicit(&glas_rt.gc.prefetch, memory_order_relaxed);
+    for(size_t mode = 0; mode < 2; ++mode) {
+        atomic_store_explicit(&glas_rt.gc.prefetch, (0 == mode), memory_order_relaxed);
+        mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 1), "GC did not run");
+        uint64_t const start = atomic_load_explicit(&glas_rt.stat.gc_mark_cells, memory_order_relaxed);
+        mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 1), "GC did not run");
+        counts[mode] = atomic_load_explicit(&glas_rt.stat.gc_mark_cells, memory_order_relaxed) - start;
+    }
+    atomic_store_explicit(&glas_rt.gc.prefetch, prior, memory_order_relaxed);
+    glas_data_drop(test.g, 1);
+    mu_assert(counts[0] >= 2000, "expecting rooted cells traced with prefetch");
+    mu_assert(counts[1] >= 2000, "expecting rooted cells traced without prefetch");
+}
+MU_TEST(test_gc_satb) {
+    // write-barrier snapshots are buffered per thread without touching 
+    // shared state. We discard rather than flush the buffer because GC
+    // only expects snapshots during its mark phase.
+    uint8_t buf[24];
+    memset(buf, 0x3C, sizeof(buf));
+    glas_os_thread* const t = glas_os_thread_get();
+    glas_os_thread_enter_busy();
+    uint64_t const resume_start = atomic_load_explicit(&glas_rt.stat.gc_wb_resume, memory_order_relaxed);
+    size_t const fill_start = (NULL == t->satb) ? 0 : t->satb->fill;
+    glas_cell* const cell = glas_cell_binary_alloc(buf, sizeof(buf));
+    for(size_t ix = 0; ix < 3; ++ix) {
+        glas_wb_snapshot_push(cell);
+    }
+    size_t const buffered = t->satb->fill - fill_start;
+    uint64_t const resume_end = atomic_load_explicit(&glas_rt.stat.gc_wb_resume, memory_order_relaxed);
+    t->satb->fill = fill_start;
+    glas_os_thread_exit_busy();
+    mu_assert_int_eq(3, (int) buffered);
+    mu_assert(resume_start == resume_end, "expecting no flush while busy");
+}
+MU_TEST(test_gc_worker_count) {
+    // wake workers in proportion to mark work, up to the pool limit
+    mu_assert_int_eq(0, (int) glas_gc_heuristic_worker_count(0, 63));
+    mu_assert_int_eq(0, (int) glas_gc_heuristic_worker_count(GLAS_GC_WORKER_PAGES - 1, 63));
+    mu_assert_int_eq(3, (int) glas_gc_heuristic_worker_count(3 * GLAS_GC_WORKER_PAGES, 63));
+    mu_assert_int_eq(63, (int) glas_gc_heuristic_worker_count(1000 * GLAS_GC_WORKER_PAGES, 63));
+    mu_assert_int_eq(0, (int) glas_gc_heuristic_worker_count(1000 * GLAS_GC_WORKER_PAGES, 0));
+    mu_assert(glas_gc_workers_are_done() || glas_rt.gc.marking, "workers park between cycles");
+}
+typedef struct {
+    glas_gc_deque* dq;
+    char const* base;
+    _Atomic(uint32_t)* seen;
+    _Atomic(bool) done;
+} test_gc_deque_ctx;
+LOCAL void* test_gc_deque_thief(void* arg) {
+    test_gc_deque_ctx* const ctx = arg;
+    do {
+        glas_gc_mb* const mb = glas_gc_deque_steal(ctx->dq);
+        if(NULL != mb) {
+            atomic_fetch_add_explicit(ctx->seen + ((char const*)mb - ctx->base), 1, memory_order_relaxed);
+        } else if(atomic_load_explicit(&(ctx->done), memory_order_acquire) &&
+                  glas_gc_deque_is_empty(ctx->dq)) {
+            return NULL;
+        }
+    } while(1);
+}
+MU_TEST(test_gc_deque) {
+    // owner pushes and pops while thieves steal; every buffer is taken
+    // exactly once. Buffers are never dereferenced, so we use tokens.
+    static size_t const item_count = 200000;
+    static size_t const thread_count = 3;
+    glas_gc_deque* const dq = aligned_alloc(64, sizeof(glas_gc_deque));
+    glas_gc_deque_init(dq, 1);
+    char* const base = malloc(item_count);
+    test_gc_deque_ctx ctx = { .dq = dq, .base = base };
+    ctx.seen = calloc(item_count, sizeof(_Atomic(uint32_t)));
+    atomic_init(&(ctx.done), false);
+    pthread_t threads[thread_count];
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_create(threads + ix, NULL, &test_gc_deque_thief, &ctx);
+    }
+    for(size_t ix = 0; ix < item_count; ++ix) {
+        glas_gc_mb* const mb = (glas_gc_mb*)(base + ix);
+        while(!glas_gc_deque_push(dq, mb)) {
+            glas_gc_mb* const taken = glas_gc_deque_pop(dq); // full
+            if(NULL != taken) {
+                atomic_fetch_add_explicit(ctx.seen + ((char const*)taken - base), 1, memory_order_relaxed);
+            }
+        }
+        if(0 == (ix % 3)) {
+            glas_gc_mb* const taken = glas_gc_deque_pop(dq);
+            if(NULL != taken) {
+                atomic_fetch_add_explicit(ctx.seen + ((char const*)taken - base), 1, memory_order_relaxed);
+            }
+        }
+    }
+    atomic_store_explicit(&(ctx.done), true, memory_order_release);
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_join(threads[ix], NULL);
+    }
+    size_t once = 0;
+    for(size_t ix = 0; ix < item_count; ++ix) {
+        once += (1 == atomic_load_explicit(ctx.seen + ix, memory_order_relaxed));
+    }
+    free(ctx.seen);
+    free(base);
+    free(dq);
+    mu_assert_int_eq((int) item_count, (int) once);
+}
+LOCAL void* test_concurrent_alloc_thread(void* arg) {
+    (void)arg;
+    uint8_t buf[24];
+    memset(buf, 0x42, sizeof(buf));
+    for(size_t round = 0; round < 100; ++round) {
+        glas_os_thread_enter_busy();
+        for(size_t ix = 0; ix < 5000; ++ix) {
+            (void) glas_cell_binary_alloc(buf, sizeof(buf));
+        }
+        glas_os_thread_exit_busy();
+    }
+    return NULL; // thread cleanup releases pages
+}
+MU_TEST(test_concurrent_alloc) {
+    // many threads acquire and release pages concurrently with GC
+    static size_t const thread_count = 4;
+    uint64_t const page_alloc_start = atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed);
+    pthread_t threads[thread_count];
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_create(threads + ix, NULL, &test_concurrent_alloc_thread, NULL);
+    }
+    for(size_t ix = 0; ix < thread_count; ++ix) {
+        pthread_join(threads[ix], NULL);
+    }
+    mu_assert(test_gc_wait_cycles(GLAS_GC_FULL, 2), "GC did not run");
+    uint64_t const page_alloc_end = atomic_load_explicit(&glas_rt.stat.page_alloc, memory_order_relaxed);
+    mu_assert(page_alloc_end >= (page_alloc_start + (thread_count * 4)), "expecting pages acquired");
+}
 MU_TEST_SUITE(test_glas) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
     MU_RUN_TEST(test_bitmanip);
     MU_RUN_TEST(test_uint);
     MU_RUN_TEST(test_int);
     MU_RUN_TEST(test_big_bits);
+    MU_RUN_TEST(test_stack_spill);
+    MU_RUN_TEST(test_stack_chunks);
+    MU_RUN_TEST(test_thread_state_pool);
+    MU_RUN_TEST(test_api_session);
+    MU_RUN_TEST(test_data_exec);
+    MU_RUN_TEST(test_data_move);
+    MU_RUN_TEST(test_unpair);
+    MU_RUN_TEST(test_list_rope);
+    MU_RUN_TEST(test_data_len);
+    MU_RUN_TEST(test_int_array);
+    MU_RUN_TEST(test_bits_of_bin);
     MU_RUN_TEST(test_finalizers);
+    MU_RUN_TEST(test_gc_decref);
+    MU_RUN_TEST(test_gc_fin_cards);
+    MU_RUN_TEST(test_medium_blocks);
+    MU_RUN_TEST(test_gc_cards);
+    MU_RUN_TEST(test_gc_compact);
+    MU_RUN_TEST(test_heap_reclaim);
+    MU_RUN_TEST(test_numa_pages);
+    MU_RUN_TEST(test_gc_pacer);
+    MU_RUN_TEST(test_gc_prefetch);
+    MU_RUN_TEST(test_gc_satb);
+    MU_RUN_TEST(test_gc_stack_snapshot);
+    MU_RUN_TEST(test_page_lists);
+    MU_RUN_TEST(test_gc_deque);
+    MU_RUN_TEST(test_gc_worker_count);
+    MU_RUN_TEST(test_concurrent_alloc);
 }
 API bool glas_rt_run_builtin_tests() {
     glas_rt_init();
@@ -3793,3 +8583,368 @@ API bool glas_rt_run_builtin_tests() {
     return (0 == MU_EXIT_CODE);
 }
 
+
+/*******************************************
+ * BUILT-IN BENCHMARKS
+ ******************************************/
+
+LOCAL double bench_now() {
+    struct timespec tm;
+    clock_gettime(CLOCK_MONOTONIC, &tm);
+    return (double)tm.tv_sec + ((double)tm.tv_nsec / 1e9);
+}
+LOCAL void bench_shuffle(glas_cell** data, size_t len) {
+    uint64_t rng = UINT64_C(0x9E3779B97F4A7C15);
+    for(size_t ix = len; ix > 1; --ix) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t const jx = (size_t)(rng % ix);
+        glas_cell* const tmp = data[ix - 1];
+        data[ix - 1] = data[jx];
+        data[jx] = tmp;
+    }
+}
+LOCAL glas_cell* bench_gc_tree_alloc(size_t leaf_count) {
+    // Build bottom-up, pairing shuffled nodes from the prior level, so
+    // tracing visits cells in scattered order like an aged heap. Caller
+    // is busy, so new cells are safe until rooted.
+    uint8_t buf[16];
+    memset(buf, 0x5A, sizeof(buf));
+    glas_cell** const level = malloc(leaf_count * sizeof(glas_cell*));
+    for(size_t ix = 0; ix < leaf_count; ++ix) {
+        level[ix] = glas_cell_binary_alloc(buf, sizeof(buf));
+    }
+    size_t len = leaf_count;
+    while(len > 1) {
+        bench_shuffle(level, len);
+        size_t const next_len = (len + 1) / 2;
+        for(size_t ix = 0; ix < next_len; ++ix) {
+            glas_cell* node[2] = { level[2*ix], ((2*ix + 1) < len) ? level[2*ix + 1] : GLAS_VAL_UNIT };
+            level[ix] = glas_cell_array_alloc(node, 2);
+        }
+        len = next_len;
+    }
+    glas_cell* const root = level[0];
+    free(level);
+    return root;
+}
+LOCAL glas_cell* bench_gc_list_alloc(size_t len) {
+    // list nodes in allocation order, each holding a scattered payload
+    uint8_t buf[16];
+    memset(buf, 0xA5, sizeof(buf));
+    glas_cell** const items = malloc(len * sizeof(glas_cell*));
+    for(size_t ix = 0; ix < len; ++ix) {
+        items[ix] = glas_cell_binary_alloc(buf, sizeof(buf));
+    }
+    bench_shuffle(items, len);
+    glas_cell* list = GLAS_VAL_UNIT;
+    for(size_t ix = 0; ix < len; ++ix) {
+        glas_cell* node[2] = { items[ix], list };
+        list = glas_cell_array_alloc(node, 2);
+    }
+    free(items);
+    return list;
+}
+LOCAL double bench_gc_mark_rate(bool prefetch, size_t cycles) {
+    // cells traced per second of marking, over a few full GC cycles
+    bool const prior = atomic_exchange_explicit(&glas_rt.gc.prefetch, prefetch, memory_order_relaxed);
+    test_gc_wait_cycles(GLAS_GC_FULL, 1); // apply setting
+    uint64_t const cells_start = atomic_load_explicit(&glas_rt.stat.gc_mark_cells, memory_order_relaxed);
+    uint64_t const nsec_start = atomic_load_explicit(&glas_rt.stat.gc_mark_nsec, memory_order_relaxed);
+    test_gc_wait_cycles(GLAS_GC_FULL, cycles);
+    uint64_t const cells = atomic_load_explicit(&glas_rt.stat.gc_mark_cells, memory_order_relaxed) - cells_start;
+    uint64_t const nsec = atomic_load_explicit(&glas_rt.stat.gc_mark_nsec, memory_order_relaxed) - nsec_start;
+    atomic_store_explicit(&glas_rt.gc.prefetch, prior, memory_order_relaxed);
+    return (0 == nsec) ? 0.0 : ((double)cells * 1e9 / (double)nsec);
+}
+LOCAL void bench_gc_mark(glas* g, char const* shape, glas_cell* (*alloc)(size_t), size_t arg) {
+    static size_t const cycles = 5;
+    double const t0 = bench_now();
+    glas_os_thread_enter_busy();
+    glas_thread_stack_cell_push(g, alloc(arg));
+    glas_os_thread_exit_busy();
+    double const t1 = bench_now();
+    double const lifo = bench_gc_mark_rate(false, cycles);
+    double const fifo = bench_gc_mark_rate(true, cycles);
+    fprintf(stdout, "gc mark %-5s build %6.3fs  lifo %8.2f Mcells/s  prefetch %8.2f Mcells/s  (%+.1f%%)\n", 
+        shape, (t1 - t0), (lifo / 1e6), (fifo / 1e6), 
+        ((lifo > 0.0) ? (100.0 * (fifo - lifo) / lifo) : 0.0));
+    glas_data_drop(g, 1);
+}
+LOCAL double bench_api_ops_rate(glas* g, bool session, size_t rounds) {
+    // API data ops per second, a small mix of stack ops and allocations
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < rounds; ++ix) {
+        if(session) { glas_session_begin(g); }
+        for(size_t jx = 0; jx < 64; ++jx) {
+            glas_i64_push(g, (int64_t)jx);
+            glas_i64_push(g, (int64_t)ix);
+            glas_data_swap(g);
+            glas_mkp(g);
+            glas_data_drop(g, 1);
+        }
+        if(session) { glas_session_end(g); }
+    }
+    double const t1 = bench_now();
+    return (double)(rounds * 64 * 5) / (t1 - t0);
+}
+LOCAL double bench_api_exec_rate(glas* g, size_t rounds) {
+    // the same op mix as bench_api_ops_rate, submitted as one batch
+    glas_op ops[64 * 5];
+    for(size_t jx = 0; jx < 64; ++jx) {
+        glas_op* const op = ops + (5 * jx);
+        op[0] = (glas_op){ GLAS_OP_I64, (int64_t)jx };
+        op[1] = (glas_op){ GLAS_OP_I64, 0 };
+        op[2] = (glas_op){ GLAS_OP_SWAP, 0 };
+        op[3] = (glas_op){ GLAS_OP_MKP, 0 };
+        op[4] = (glas_op){ GLAS_OP_DROP, 1 };
+    }
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < rounds; ++ix) {
+        for(size_t jx = 0; jx < 64; ++jx) { ops[5 * jx + 1].arg = (int64_t)ix; }
+        (void) glas_data_exec(g, ops, 64 * 5);
+    }
+    double const t1 = bench_now();
+    return (double)(rounds * 64 * 5) / (t1 - t0);
+}
+LOCAL void bench_api_session(glas* g) {
+    static size_t const rounds = 1 << 15;
+    (void) bench_api_ops_rate(g, false, rounds / 8); // warm up
+    double const plain = bench_api_ops_rate(g, false, rounds);
+    double const session = bench_api_ops_rate(g, true, rounds);
+    fprintf(stdout, "api ops  plain %6.1f ns/op  session %6.1f ns/op  (%+.1f%%)\n",
+        (1e9 / plain), (1e9 / session), (100.0 * (session - plain) / plain));
+    double const exec = bench_api_exec_rate(g, rounds);
+    fprintf(stdout, "api ops  exec  %6.1f ns/op  (%+.1f%% vs plain)\n",
+        (1e9 / exec), (100.0 * (exec - plain) / plain));
+}
+LOCAL void bench_data_move(glas* g) {
+    static size_t const rounds = 1 << 22;
+    glas_moves plan;
+    bool const ok = glas_moves_compile(&plan, "abcd-cdab");
+    assert(ok); (void)ok;
+    for(int64_t ix = 1; ix <= 4; ++ix) { glas_i64_push(g, ix); }
+    glas_session_begin(g);
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < rounds; ++ix) { glas_data_move(g, "abcd-cdab"); }
+    double const t1 = bench_now();
+    for(size_t ix = 0; ix < rounds; ++ix) { glas_data_move_exec(g, &plan); }
+    double const t2 = bench_now();
+    glas_session_end(g);
+    glas_data_drop(g, 4);
+    fprintf(stdout, "data move  string %6.1f ns/op  plan %6.1f ns/op\n",
+        (1e9 * (t1 - t0) / rounds), (1e9 * (t2 - t1) / rounds));
+}
+LOCAL void bench_stack_depth(glas* g, size_t depth) {
+    // deep stacks spill to and refill from overflow
+    static size_t const total = (size_t)1 << 22;
+    size_t const rounds = (total / depth) + 1;
+    glas_session_begin(g);
+    double const t0 = bench_now();
+    for(size_t round = 0; round < rounds; ++round) {
+        for(size_t ix = 0; ix < depth; ++ix) {
+            glas_i64_push(g, (int64_t)ix);
+        }
+        for(size_t ix = 0; ix < depth; ++ix) {
+            glas_data_drop(g, 1);
+        }
+    }
+    double const t1 = bench_now();
+    glas_session_end(g);
+    fprintf(stdout, "stack depth %-7zu %6.1f ns/op\n", depth,
+        (1e9 * (t1 - t0) / (double)(2 * rounds * depth)));
+}
+LOCAL void bench_api_marking(glas* g) {
+    // stack-heavy API ops while GC marks a large live heap
+    static size_t const cycles = 8;
+    glas_os_thread_enter_busy();
+    glas_thread_stack_cell_push(g, bench_gc_tree_alloc((size_t)1 << 20));
+    glas_os_thread_exit_busy();
+    size_t ops = 0;
+    double elapsed = 0.0;
+    glas_session_begin(g);
+    for(size_t cycle = 0; cycle < cycles; ++cycle) {
+        uint64_t const goal = 1 + atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire);
+        glas_rt_gc_trigger(GLAS_GC_FULL);
+        do {
+            bool const marking0 = glas_rt.gc.marking;
+            double const t0 = bench_now();
+            for(size_t ix = 0; ix < 64; ++ix) {
+                glas_i64_push(g, (int64_t)ix);
+                glas_i64_push(g, (int64_t)cycle);
+                glas_data_swap(g);
+                glas_data_drop(g, 1);
+                glas_data_drop(g, 1);
+            }
+            double const t1 = bench_now();
+            if(marking0 && glas_rt.gc.marking) {
+                ops += 64 * 5;
+                elapsed += (t1 - t0);
+            }
+        } while(glas_rt.gc.marking || 
+                (goal > atomic_load_explicit(&glas_rt.gc.cycle, memory_order_acquire)));
+    }
+    glas_session_end(g);
+    glas_data_drop(g, 1);
+    fprintf(stdout, "api ops  during mark %6.1f ns/op  (%zu ops, %s stacks)\n",
+        ((ops > 0) ? (1e9 * elapsed / (double)ops) : 0.0), ops,
+        GLAS_GC_EAGER_STACKS ? "eager" : "barrier");
+}
+LOCAL void bench_unp_walk(glas* g, char const* what, size_t len) {
+    // L -- ; iterate a list via unp, dropping each head
+    glas_session_begin(g);
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < len; ++ix) {
+        glas_unp(g);
+        glas_data_swap(g);
+        glas_data_drop(g, 1);
+    }
+    double const t1 = bench_now();
+    glas_data_drop(g, 1);
+    glas_session_end(g);
+    fprintf(stdout, "unp walk %-6s %zu items  %6.1f ns/item\n", what, len,
+        (1e9 * (t1 - t0) / (double)len));
+}
+LOCAL void bench_unp(glas* g) {
+    static size_t const len = (size_t)4 << 20;
+    uint8_t* const buf = malloc(len);
+    memset(buf, 0x5A, len);
+    glas_binary_push(g, buf, len);
+    free(buf);
+    bench_unp_walk(g, "binary", len);
+    size_t const arr_len = len / 4;
+    glas_cell** const data = malloc(arr_len * sizeof(glas_cell*));
+    for(size_t ix = 0; ix < arr_len; ++ix) { data[ix] = GLAS_VAL_UNIT; }
+    glas_os_thread_enter_busy();
+    glas_thread_stack_cell_push(g, glas_cell_array_alloc(data, arr_len));
+    glas_os_thread_exit_busy();
+    free(data);
+    bench_unp_walk(g, "array", arr_len);
+}
+LOCAL void bench_list_rope(glas* g) {
+    // build a rope by small appends, then random index and split/append
+    static size_t const len = (size_t)1 << 20;
+    static size_t const ops = (size_t)1 << 16;
+    uint8_t buf[64];
+    memset(buf, 0x5A, sizeof(buf));
+    glas_session_begin(g);
+    glas_binary_push(g, buf, 0);
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < len; ix += 16) {
+        glas_binary_push(g, buf, 16);
+        glas_list_append(g);
+    }
+    double const t1 = bench_now();
+    uint64_t seed = 1;
+    for(size_t ix = 0; ix < ops; ++ix) {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        glas_i64_push(g, (int64_t)((seed >> 33) % len));
+        glas_list_index(g);
+        glas_data_drop(g, 1);
+    }
+    double const t2 = bench_now();
+    for(size_t ix = 0; ix < ops; ++ix) {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        glas_i64_push(g, (int64_t)((seed >> 33) % len));
+        glas_list_split(g);
+        glas_list_append(g);
+    }
+    double const t3 = bench_now();
+    for(size_t ix = 0; ix < ops; ++ix) {
+        glas_list_len(g);
+        glas_data_drop(g, 1);
+    }
+    double const t4 = bench_now();
+    glas_data_drop(g, 1);
+    glas_session_end(g);
+    fprintf(stdout, "rope append  %zu x 16B     %6.1f ns/op\n", len / 16,
+        (1e9 * (t1 - t0) / (double)(len / 16)));
+    fprintf(stdout, "rope index   %zu items   %6.1f ns/op\n", len,
+        (1e9 * (t2 - t1) / (double)ops));
+    fprintf(stdout, "rope split+append          %6.1f ns/op\n",
+        (1e9 * (t3 - t2) / (double)ops));
+    fprintf(stdout, "rope len                   %6.1f ns/op\n",
+        (1e9 * (t4 - t3) / (double)ops));
+}
+LOCAL void bench_int_array(glas* g) {
+    // million-element i64 arrays: push, peek, and unp walk
+    static size_t const len = (size_t)1 << 20;
+    static size_t const reps = 16;
+    int64_t* const buf = malloc(len * sizeof(int64_t));
+    for(size_t ix = 0; ix < len; ++ix) { buf[ix] = (int64_t)(ix * 1000003); }
+    glas_session_begin(g);
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < reps; ++ix) {
+        glas_i64_array_push(g, buf, len);
+        glas_data_drop(g, 1);
+    }
+    double const t1 = bench_now();
+    glas_i64_array_push(g, buf, len);
+    size_t amt = 0;
+    for(size_t ix = 0; ix < reps; ++ix) {
+        glas_i64_array_peek(g, 0, len, buf, &amt);
+    }
+    double const t2 = bench_now();
+    glas_session_end(g);
+    free(buf);
+    fprintf(stdout, "int array push %zu x i64   %6.2f ns/item\n", len,
+        (1e9 * (t1 - t0) / (double)(len * reps)));
+    fprintf(stdout, "int array peek %zu x i64   %6.2f ns/item\n", len,
+        (1e9 * (t2 - t1) / (double)(len * reps)));
+    bench_unp_walk(g, "i64", len);
+}
+LOCAL void bench_bits_of_bin(glas* g) {
+    // 1MB binary to bitstring and back, aligned and unaligned
+    static size_t const len = (size_t)1 << 20;
+    static size_t const reps = 1000;
+    uint8_t* const buf = malloc(len);
+    for(size_t ix = 0; ix < len; ++ix) { buf[ix] = (uint8_t)(ix * 31); }
+    glas_session_begin(g);
+    glas_binary_push(g, buf, len);
+    double const t0 = bench_now();
+    for(size_t ix = 0; ix < reps; ++ix) {
+        glas_bits_of_bin(g);
+        glas_bits_to_bin(g);
+    }
+    double const t1 = bench_now();
+    glas_bits_of_bin(g);
+    for(size_t ix = 0; ix < reps; ++ix) {
+        glas_u64_push(g, 1 + (ix * 7919) % (8 * len));
+        glas_bits_split(g);
+        glas_bits_append(g);
+    }
+    double const t2 = bench_now();
+    glas_u64_push(g, 3);
+    glas_bits_split(g);
+    glas_data_swap(g);
+    glas_bits_append(g);
+    glas_bits_to_bin(g);
+    double const t3 = bench_now();
+    glas_data_drop(g, 1);
+    glas_session_end(g);
+    free(buf);
+    fprintf(stdout, "bits of/to bin 1MB aligned  %8.2f ns/op\n",
+        (1e9 * (t1 - t0) / (double)reps));
+    fprintf(stdout, "bits split+append in view   %8.2f ns/op\n",
+        (1e9 * (t2 - t1) / (double)reps));
+    fprintf(stdout, "bits to bin 1MB unaligned   %8.2f ns/byte\n",
+        (1e9 * (t3 - t2) / (double)len));
+}
+API bool glas_rt_run_builtin_bench() {
+    glas_rt_init();
+    glas* const g = glas_thread_new();
+    bench_gc_mark(g, "list", &bench_gc_list_alloc, (size_t)1 << 21);
+    bench_gc_mark(g, "tree", &bench_gc_tree_alloc, (size_t)1 << 20);
+    bench_api_session(g);
+    bench_data_move(g);
+    bench_api_marking(g);
+    bench_stack_depth(g, 1000);
+    bench_stack_depth(g, 100000);
+    bench_unp(g);
+    bench_list_rope(g);
+    bench_int_array(g);
+    bench_bits_of_bin(g);
+    glas_thread_exit(g);
+    glas_rt_tls_reset();
+    fflush(stdout);
+    return true;
+}
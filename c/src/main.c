@@ -38,6 +38,8 @@
   "       if this is a binary, print to standard output\n"\
   "    glas --bit TestName*\n"\
   "       run built-in tests. If no TestName, runs all tests.\n"\
+  "    glas --bench\n"\
+  "       run built-in benchmarks, printing results\n"\
   ""
 
 #include <stdlib.h>
@@ -55,6 +57,7 @@ typedef enum glas_act {
     GLAS_ACT_HELP = 0,
     // getting started
     GLAS_ACT_BUILT_IN_TEST,
+    GLAS_ACT_BUILT_IN_BENCH,
     GLAS_ACT_EXTRACT_BINARY,
     // getting ambitious
     GLAS_ACT_RUN,
@@ -95,6 +98,9 @@ glas_cli_options* glas_cli_parse_args(int argc, char const* const* argv) {
     } else if(0 == strcmp("--bit", argv[0])) {
         result->action = GLAS_ACT_BUILT_IN_TEST;
         CLI_ARG_STEP(1);
+    } else if(0 == strcmp("--bench", argv[0])) {
+        result->action = GLAS_ACT_BUILT_IN_BENCH;
+        CLI_ARG_STEP(1);
     } else if((0 == strcmp("--extract", argv[0])) && (argc == 2)) {
         result->action = GLAS_ACT_EXTRACT_BINARY;
         size_t const buflen = strlen(argv[1]) + 32;
@@ -151,6 +157,7 @@ glas_cli_options* glas_cli_parse_args(int argc, char const* const* argv) {
 }
 
 int glas_cli_bit(int argc, char const* const* argv);
+int glas_cli_bench();
 int glas_cli_extract(char const* src);
 
 int main(int argc, char const* const* argv) 
@@ -166,6 +173,8 @@ int main(int argc, char const* const* argv)
         fprintf(stdout, "%s", GLAS_HELP_STR);
     } else if(GLAS_ACT_BUILT_IN_TEST == pOpt->action) {
         result = glas_cli_bit(pOpt->argc_rem, pOpt->argv_rem);
+    } else if(GLAS_ACT_BUILT_IN_BENCH == pOpt->action) {
+        result = glas_cli_bench();
     } else if(GLAS_ACT_EXTRACT_BINARY == pOpt->action) {
         result = glas_cli_extract(pOpt->app_src);
     } else {
@@ -220,3 +229,10 @@ int glas_cli_bit(int argc, char const* const* argv) {
     return tests_failed;
 }
 
+int glas_cli_bench() {
+    if(!glas_rt_run_builtin_bench()) {
+        fprintf(stdout, "glas runtime built-in benchmarks failed\n");
+        return 1;
+    }
+    return 0;
+}